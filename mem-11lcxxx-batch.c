@@ -0,0 +1,316 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name:	11LC010T EEPROM USING UNI/O 1 WIRE BUS - BATCHED REQUESTS
+
+
+
+#include "main.h"					//Global data type definitions (see https://github.com/ibexuk/C_Generic_Header_File )
+
+
+#define	MEM_EXT_UNIO_BATCH_C		//(Our header file define)
+
+#include "mem-11lcxxx-batch.h"
+
+#if (UNIO_EEPROM_PAGE_SIZE > 16)
+#error "unio_batch_run_writes() uses a 16 bit mask per page"
+#endif
+
+
+//********************************
+//********************************
+//********** BATCH READ **********
+//********************************
+//********************************
+//Queue a read.  data is loaded by unio_batch_run().
+//Returns:
+//	1 if queued, 0 if the range is outside of the device
+BYTE unio_batch_read (uint16_t address, uint8_t *data, uint16_t length)
+{
+	return(unio_batch_add(address, data, length, 0));
+}
+
+
+//*********************************
+//*********************************
+//********** BATCH WRITE **********
+//*********************************
+//*********************************
+//Queue a write (may cross page boundaries).  data is written by unio_batch_run() so must not be changed before then.
+//Returns:
+//	1 if queued, 0 if the range is outside of the device
+BYTE unio_batch_write (uint16_t address, uint8_t *data, uint16_t length)
+{
+	return(unio_batch_add(address, data, length, 1));
+}
+
+
+//*******************************
+//*******************************
+//********** BATCH ADD **********
+//*******************************
+//*******************************
+BYTE unio_batch_add (uint16_t address, uint8_t *data, uint16_t length, uint8_t is_write)
+{
+	uint8_t index;
+	UNIO_BATCH_REQUEST *request;
+
+	if ((length < 1) || (((uint32_t)address + length) > UNIO_EEPROM_SIZE))
+		return(0);
+
+	//----- RUN THE QUEUE FIRST IF IT'S FULL OR THE ORDER MATTERS -----
+	for (index = 0; index < unio_batch_count; index++)
+	{
+		request = &unio_batch_requests[index];
+		if ((request->is_write != is_write) && (address < (request->address + request->length)) && (request->address < (address + length)))
+			break;								//A read and a write of the same bytes
+	}
+	if ((index < unio_batch_count) || (unio_batch_count >= UNIO_BATCH_MAX_REQUESTS))
+		unio_batch_run_queue();
+
+	request = &unio_batch_requests[unio_batch_count++];
+	request->address = address;
+	request->length = length;
+	request->data = data;
+	request->is_write = is_write;
+	return(1);
+}
+
+
+//*******************************
+//*******************************
+//********** BATCH RUN **********
+//*******************************
+//*******************************
+//Runs the queued requests.
+//Returns:
+//	1 is sucessful, 0 if any request queued since the last call failed (failed reads are set to 0x00)
+BYTE unio_batch_run (void)
+{
+	BYTE success;
+
+	unio_batch_run_queue();
+
+	success = unio_batch_failed ? 0 : 1;
+	unio_batch_failed = 0;
+	return(success);
+}
+
+
+//Run and empty the queue.  Reads and writes in the queue never touch the same bytes (see unio_batch_add()) so can run in any order.
+void unio_batch_run_queue (void)
+{
+	if (!unio_batch_run_reads())
+		unio_batch_failed = 1;
+	if (!unio_batch_run_writes())
+		unio_batch_failed = 1;
+	unio_batch_count = 0;
+}
+
+
+//**************************************
+//**************************************
+//********** BATCH RUN WRITES **********
+//**************************************
+//**************************************
+//Fold the queued writes into each page in turn (in the order queued, so the last write of a byte wins) and write the page with a single
+//unio_eeprom_write() from the first to the last byte written.  Bytes in between that weren't written are read from the device first.
+BYTE unio_batch_run_writes (void)
+{
+	UNIO_BATCH_REQUEST *request;
+	uint16_t page;
+	uint16_t first_page = 0xffff;
+	uint16_t last_page = 0;
+	uint16_t page_address;
+	uint16_t address;
+	uint16_t end;
+	uint16_t mask;
+	uint8_t index;
+	uint8_t offset;
+	uint8_t start;
+	BYTE success = 1;
+
+	//----- FIND THE PAGES WRITTEN -----
+	for (index = 0; index < unio_batch_count; index++)
+	{
+		request = &unio_batch_requests[index];
+		if (!request->is_write)
+			continue;
+		if ((request->address / UNIO_EEPROM_PAGE_SIZE) < first_page)
+			first_page = request->address / UNIO_EEPROM_PAGE_SIZE;
+		if (((request->address + request->length - 1) / UNIO_EEPROM_PAGE_SIZE) > last_page)
+			last_page = (request->address + request->length - 1) / UNIO_EEPROM_PAGE_SIZE;
+	}
+
+	for (page = first_page; page <= last_page; page++)
+	{
+		//----- FOLD THE WRITES TO THIS PAGE -----
+		page_address = page * UNIO_EEPROM_PAGE_SIZE;
+		mask = 0;
+		for (index = 0; index < unio_batch_count; index++)
+		{
+			request = &unio_batch_requests[index];
+			if ((!request->is_write) || (request->address >= (page_address + UNIO_EEPROM_PAGE_SIZE)) || ((request->address + request->length) <= page_address))
+				continue;
+
+			address = (request->address > page_address) ? request->address : page_address;
+			end = request->address + request->length;
+			if (end > (page_address + UNIO_EEPROM_PAGE_SIZE))
+				end = page_address + UNIO_EEPROM_PAGE_SIZE;
+			for ( ; address < end; address++)
+			{
+				unio_batch_page[address - page_address] = request->data[address - request->address];
+				mask |= (uint16_t)(0x0001 << (address - page_address));
+			}
+		}
+
+		if (!mask)
+			continue;
+
+		//----- FIND THE FIRST AND LAST BYTES WRITTEN -----
+		for (start = 0; !(mask & (0x0001 << start)); start++)
+			;
+		for (offset = UNIO_EEPROM_PAGE_SIZE; !(mask & (0x0001 << (offset - 1))); offset--)
+			;
+
+		//----- FILL ANY GAPS WITH THE CURRENT CONTENTS -----
+		for (index = start; (index < offset) && (mask & (0x0001 << index)); index++)
+			;
+		if (index < offset)
+		{
+			unio_batch_transactions++;
+			if (!unio_eeprom_read((page_address + start), &unio_batch_buffer[0], (offset - start)))
+			{
+				success = 0;					//(Don't write bytes that couldn't be read)
+				continue;
+			}
+			for ( ; index < offset; index++)
+			{
+				if (!(mask & (0x0001 << index)))
+					unio_batch_page[index] = unio_batch_buffer[index - start];
+			}
+		}
+
+		//----- WRITE THE PAGE -----
+		unio_batch_transactions++;
+		if (!unio_eeprom_write((page_address + start), &unio_batch_page[start], (offset - start)))
+			success = 0;
+	}
+	return(success);
+}
+
+
+//*************************************
+//*************************************
+//********** BATCH RUN READS **********
+//*************************************
+//*************************************
+//Sort the queued reads by address and read each group that fits in unio_batch_buffer with a single sequential READ
+BYTE unio_batch_run_reads (void)
+{
+	UNIO_BATCH_REQUEST *request;
+	uint8_t count = 0;
+	uint8_t index;
+	uint8_t position;
+	uint8_t first;
+	uint8_t last;
+	uint16_t run_start;
+	uint16_t run_end;
+	uint16_t end;
+	BYTE success = 1;
+
+	//----- SORT THE READS BY ADDRESS (INSERTION SORT) -----
+	for (index = 0; index < unio_batch_count; index++)
+	{
+		if (unio_batch_requests[index].is_write)
+			continue;
+
+		position = count++;
+		while ((position) && (unio_batch_requests[unio_batch_order[position - 1]].address > unio_batch_requests[index].address))
+		{
+			unio_batch_order[position] = unio_batch_order[position - 1];
+			position--;
+		}
+		unio_batch_order[position] = index;
+	}
+
+	//----- MERGE INTO RUNS -----
+	first = 0;
+	while (first < count)
+	{
+		request = &unio_batch_requests[unio_batch_order[first]];
+		run_start = request->address;
+		run_end = request->address + request->length;
+
+		for (last = first; (last + 1) < count; last++)
+		{
+			request = &unio_batch_requests[unio_batch_order[last + 1]];
+			if (request->address > (run_end + UNIO_BATCH_MAX_GAP))
+				break;							//Too far after the run
+
+			end = request->address + request->length;
+			if (end < run_end)
+				end = run_end;
+			if ((end - run_start) > UNIO_BATCH_BUFFER_SIZE)
+				break;							//Run would be too long for the buffer
+			run_end = end;
+		}
+
+		if (!unio_batch_read_run(first, last, run_start, run_end))
+			success = 0;
+		first = last + 1;
+	}
+	return(success);
+}
+
+
+//Read sorted reads first to last (start to end - 1 of the device) in a single READ
+BYTE unio_batch_read_run (uint8_t first, uint8_t last, uint16_t start, uint16_t end)
+{
+	UNIO_BATCH_REQUEST *request;
+	uint16_t count;
+	BYTE success;
+
+	unio_batch_transactions++;
+	if (first == last)
+	{
+		//Single read - straight into its own buffer
+		request = &unio_batch_requests[unio_batch_order[first]];
+		return(unio_eeprom_read(request->address, request->data, request->length));
+	}
+
+	success = unio_eeprom_read(start, &unio_batch_buffer[0], (end - start));		//(Set to 0x00 if it failed)
+
+	for ( ; first <= last; first++)
+	{
+		request = &unio_batch_requests[unio_batch_order[first]];
+		for (count = 0; count < request->length; count++)
+			request->data[count] = unio_batch_buffer[request->address - start + count];
+	}
+	return(success);
+}
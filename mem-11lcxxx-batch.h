@@ -0,0 +1,165 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name:	11LC010T EEPROM USING UNI/O 1 WIRE BUS - BATCHED REQUESTS
+
+
+
+//##################################
+//##################################
+//##### BATCHED READS & WRITES #####
+//##################################
+//##################################
+//Reads and writes are queued and then run together so they share transactions:
+//- Queued reads are sorted by address and ranges that touch, overlap or are within UNIO_BATCH_MAX_GAP bytes of each other are read
+//  in a single sequential READ into unio_batch_buffer (then copied out), so many small reads cost a few start headers.
+//- Queued writes are folded page by page (a later write of the same byte wins), so several writes to a page cost one page write.
+//  Bytes between them that weren't written are read from the device first (one READ) so the page is written from its first to its
+//  last written byte with a single unio_eeprom_write() (skipping pages already the same and verifying as set by unio_verify_policy).
+//- The effect is the same as running the requests in the order queued: a read of bytes a queued write changes (or a write of bytes a
+//  queued read hasn't read yet) first runs the requests already queued.  The queue is also run when it is full.
+//The data of each queued request must stay valid (and read data isn't ready) until unio_batch_run() returns.
+
+
+
+//##############################
+//##############################
+//##### USING IN A PROJECT #####
+//##############################
+//##############################
+/*
+	//----- STARTUP -----
+	unio_batch_read(UNIO_EEPROM_VALUE_0, (uint8_t*)&serial_number, sizeof(serial_number));
+	unio_batch_read(UNIO_EEPROM_VALUE_1, (uint8_t*)&calibration[0], sizeof(calibration));
+	unio_batch_read(UNIO_EEPROM_VALUE_2, (uint8_t*)&options, sizeof(options));
+	//...
+	if (!unio_batch_run())
+	{
+		//A READ OR WRITE FAILED (failed reads are set to 0x00)
+		Nop();
+	}
+*/
+
+
+
+//*****************************
+//*****************************
+//********** DEFINES **********
+//*****************************
+//*****************************
+#ifndef MEM_EXT_UNIO_BATCH_C_INIT		//(Do only once)
+#define	MEM_EXT_UNIO_BATCH_C_INIT
+
+#include "mem-11lcxxx.h"
+
+#define	UNIO_BATCH_MAX_REQUESTS				32			//Requests queued before the queue is run automatically
+#define	UNIO_BATCH_BUFFER_SIZE				64			//Bytes - longest merged READ (a single request longer than this is read straight into its own buffer)
+#define	UNIO_BATCH_MAX_GAP					8			//Bytes between queued reads that are read through rather than starting a new READ transaction
+
+
+typedef struct _UNIO_BATCH_REQUEST
+{
+	uint16_t address;
+	uint16_t length;
+	uint8_t *data;
+	uint8_t is_write;
+} UNIO_BATCH_REQUEST;
+
+
+#endif
+
+
+//*******************************
+//*******************************
+//********** FUNCTIONS **********
+//*******************************
+//*******************************
+#ifdef MEM_EXT_UNIO_BATCH_C
+//-----------------------------------
+//----- INTERNAL ONLY FUNCTIONS -----
+//-----------------------------------
+BYTE unio_batch_add (uint16_t address, uint8_t *data, uint16_t length, uint8_t is_write);
+BYTE unio_batch_run_writes (void);
+BYTE unio_batch_run_reads (void);
+BYTE unio_batch_read_run (uint8_t first, uint8_t last, uint16_t start, uint16_t end);
+void unio_batch_run_queue (void);
+
+
+//-----------------------------------------
+//----- INTERNAL & EXTERNAL FUNCTIONS -----
+//-----------------------------------------
+//(Also defined below as extern)
+BYTE unio_batch_read (uint16_t address, uint8_t *data, uint16_t length);
+BYTE unio_batch_write (uint16_t address, uint8_t *data, uint16_t length);
+BYTE unio_batch_run (void);
+
+#else
+//------------------------------
+//----- EXTERNAL FUNCTIONS -----
+//------------------------------
+extern BYTE unio_batch_read (uint16_t address, uint8_t *data, uint16_t length);
+extern BYTE unio_batch_write (uint16_t address, uint8_t *data, uint16_t length);
+extern BYTE unio_batch_run (void);
+
+#endif
+
+
+
+
+//****************************
+//****************************
+//********** MEMORY **********
+//****************************
+//****************************
+#ifdef MEM_EXT_UNIO_BATCH_C
+//--------------------------------------------
+//----- INTERNAL ONLY MEMORY DEFINITIONS -----
+//--------------------------------------------
+UNIO_BATCH_REQUEST unio_batch_requests[UNIO_BATCH_MAX_REQUESTS];
+uint8_t unio_batch_count;
+uint8_t unio_batch_order[UNIO_BATCH_MAX_REQUESTS];			//Queued reads sorted by address
+uint8_t unio_batch_failed;										//A request failed since the last unio_batch_run()
+uint8_t unio_batch_buffer[UNIO_BATCH_BUFFER_SIZE];
+uint8_t unio_batch_page[UNIO_EEPROM_PAGE_SIZE];
+
+
+//--------------------------------------------------
+//----- INTERNAL & EXTERNAL MEMORY DEFINITIONS -----
+//--------------------------------------------------
+//(Also defined below as extern)
+uint16_t unio_batch_transactions;				//READ transactions and page writes used by batches (for monitoring)
+
+
+#else
+//---------------------------------------
+//----- EXTERNAL MEMORY DEFINITIONS -----
+//---------------------------------------
+extern uint16_t unio_batch_transactions;
+
+
+#endif
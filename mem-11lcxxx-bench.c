@@ -0,0 +1,282 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name: 11LC010T EEPROM USING UNI/O 1 WIRE BUS - BENCHMARK
+
+
+
+#include "main.h"					//Global data type definitions (see https://github.com/ibexuk/C_Generic_Header_File )
+#include <stdio.h>
+#include <string.h>
+
+
+#define	MEM_EXT_UNIO_BENCH_C		//(Our header file define)
+
+#include "mem-11lcxxx-bench.h"
+
+
+
+//************************************
+//************************************
+//********** RUN BENCHMARKS **********
+//************************************
+//************************************
+//Output is CSV on stdout, see the header file for the columns.
+void unio_bench_run (void)
+{
+	unio_bench_print = 1;
+	unio_bench_measure();
+}
+
+
+
+//**************************************
+//**************************************
+//********** CHECK BENCHMARKS **********
+//**************************************
+//**************************************
+//Runs the benchmarks without printing and compares each row with a CSV file saved from unio_bench_run() (e.g. by a previous driver
+//version).  A row fails if its result differs, or its bus_bits, elapsed_us or int_disabled_max_us is more than threshold_percent
+//above the baseline.  Simulator times are exact, so a small threshold can be used.  Failed and missing rows are printed on stdout.
+//Returns:
+//	1 if all rows are within the threshold, 0 if not or the baseline file couldn't be read
+BYTE unio_bench_check (const char *baseline_file, uint8_t threshold_percent)
+{
+	FILE *file;
+	UNIO_BENCH_RESULT *row;
+	char line[160];
+	char operation[16];
+	unsigned int bytes;
+	unsigned long bit_rate_hz;
+	unsigned int result;
+	unsigned long bus_bits;
+	unsigned long elapsed_us;
+	unsigned long int_disabled_max_us;
+	uint8_t index;
+	uint8_t rows = 0;
+	BYTE success = 1;
+
+	unio_bench_print = 0;
+	unio_bench_measure();
+
+	file = fopen(baseline_file, "r");
+	if (!file)
+	{
+		printf("bench: can't open %s\n", baseline_file);
+		return(0);
+	}
+
+	while (fgets(line, sizeof(line), file))
+	{
+		if (sscanf(line, "%15[^,],%u,%lu,%u,%lu,%*u,%*d,%lu,%*u,%*u,%lu", operation, &bytes, &bit_rate_hz, &result, &bus_bits,
+					&elapsed_us, &int_disabled_max_us) != 7)
+			continue;							//(Header line)
+		rows++;
+
+		for (index = 0; index < unio_bench_result_count; index++)
+		{
+			row = &unio_bench_results[index];
+			if ((strcmp(row->operation, operation) == 0) && (row->bytes == bytes) && (row->bit_rate_hz == bit_rate_hz))
+				break;
+		}
+		if (index >= unio_bench_result_count)
+		{
+			printf("bench: %s,%u,%lu missing\n", operation, bytes, bit_rate_hz);
+			success = 0;
+			continue;
+		}
+
+		if (row->result != result)
+		{
+			printf("bench: %s,%u,%lu result %u, baseline %u\n", operation, bytes, bit_rate_hz, (unsigned int)row->result, result);
+			success = 0;
+		}
+		success &= unio_bench_check_value(row, "bus_bits", row->bus_bits, bus_bits, threshold_percent);
+		success &= unio_bench_check_value(row, "elapsed_us", row->elapsed_us, elapsed_us, threshold_percent);
+		success &= unio_bench_check_value(row, "int_disabled_max_us", row->int_disabled_max_us, int_disabled_max_us, threshold_percent);
+	}
+	fclose(file);
+
+	if (rows != unio_bench_result_count)
+	{
+		printf("bench: %u rows, baseline has %u\n", (unsigned int)unio_bench_result_count, (unsigned int)rows);
+		success = 0;
+	}
+	return(success);
+}
+
+
+//Returns:
+//	1 if value is no more than threshold_percent above baseline, 0 if it is (and prints it)
+BYTE unio_bench_check_value (UNIO_BENCH_RESULT *row, const char *column, uint32_t value, uint32_t baseline, uint8_t threshold_percent)
+{
+	if ((uint64_t)value * 100 <= ((uint64_t)baseline * (100 + threshold_percent)))
+		return(1);
+
+	printf("bench: %s,%u,%lu %s %lu, baseline %lu (+%u%% allowed)\n", row->operation, (unsigned int)row->bytes, (unsigned long)row->bit_rate_hz,
+			column, (unsigned long)value, (unsigned long)baseline, (unsigned int)threshold_percent);
+	return(0);
+}
+
+
+
+//**************************************
+//**************************************
+//********** RUN ALL MEASURES **********
+//**************************************
+//**************************************
+void unio_bench_measure (void)
+{
+	static const uint16_t quarter_periods[] = UNIO_BENCH_QUARTER_PERIODS;
+	static const uint16_t read_sizes[] = UNIO_BENCH_READ_SIZES;
+	static const uint8_t write_sizes[] = UNIO_BENCH_WRITE_SIZES;
+	UNIO_BULK_WRITE_RESULT write_result;
+	uint8_t speed;
+	uint8_t size;
+	uint16_t count;
+	BYTE result;
+
+	unio_bench_result_count = 0;
+	if (unio_bench_print)
+		printf("operation,bytes,bit_rate_hz,result,bus_bits,payload_bits,overhead_bits,elapsed_us,write_cycle_us,int_disabled_us,int_disabled_max_us,bytes_per_s\n");
+
+	for (count = 0; count < UNIO_EEPROM_SIZE; count++)
+		unio_bench_data[count] = (uint8_t)count;
+
+	for (speed = 0; speed < (sizeof(quarter_periods) / sizeof(quarter_periods[0])); speed++)
+	{
+		//----- POWER ON A FRESH DEVICE AT THIS SPEED -----
+		unio_sim_reset();
+		unio_sim_device.size = UNIO_EEPROM_SIZE;
+		unio_set_bus_speed(quarter_periods[speed]);
+		unio_eeprom_init();
+
+		//----- STANDBY PULSE -----
+		unio_bench_start();
+		unio_standby_pulse();
+		unio_bench_report("standby", 0, 1);
+
+		//----- IS PRESENT -----
+		unio_bench_start();
+		result = unio_is_eeprom_present();
+		unio_bench_report("present", 0, result);
+
+		//----- READ -----
+		for (size = 0; size < (sizeof(read_sizes) / sizeof(read_sizes[0])); size++)
+		{
+			unio_bench_start();
+			result = unio_eeprom_read(0x0000, &unio_bench_data[0], read_sizes[size]);
+			unio_bench_report("read", read_sizes[size], result);
+		}
+
+		//----- WRITE -----
+		unio_eeprom_write(0x0000, &unio_bench_data[0], 1);		//Let the write cycle time be learnt first (unio_set_bus_speed() clears it) so writes are timed as in normal use
+
+		for (size = 0; size < (sizeof(write_sizes) / sizeof(write_sizes[0])); size++)
+		{
+			for (count = 0; count < write_sizes[size]; count++)
+				unio_bench_data[count] ^= 0xff;			//(Data the device doesn't already hold, so the write isn't skipped by UNIO_WRITE_SKIP_UNCHANGED)
+
+			unio_bench_start();
+			result = unio_eeprom_write(0x0000, &unio_bench_data[0], write_sizes[size]);
+			unio_bench_report("write", write_sizes[size], result);
+		}
+
+		//----- BULK WRITE -----
+		unio_bench_start();
+		result = unio_eeprom_write_bulk(0x0000, &unio_bench_data[0], UNIO_EEPROM_SIZE, &write_result);
+		unio_bench_report("write_bulk", UNIO_EEPROM_SIZE, result);
+	}
+}
+
+
+
+//***********************************
+//***********************************
+//********** START MEASURE **********
+//***********************************
+//***********************************
+void unio_bench_start (void)
+{
+	unio_bench_start_stats = unio_sim_stats;
+}
+
+
+
+//************************************
+//************************************
+//********** REPORT MEASURE **********
+//************************************
+//************************************
+void unio_bench_report (const char *operation, uint16_t bytes, BYTE result)
+{
+	uint64_t bit_ns;
+	uint64_t elapsed_ns;
+	uint32_t bus_bits;
+	uint32_t payload_bits;
+	uint32_t bytes_per_s;
+	UNIO_BENCH_RESULT *row;
+
+	bit_ns = (uint64_t)unio_quarter_period * UNIO_EEPROM_TIMER_COUNT_NS * 4;
+	elapsed_ns = unio_sim_stats.elapsed_ns - unio_bench_start_stats.elapsed_ns;
+	bus_bits = (uint32_t)((unio_sim_stats.bus_active_ns - unio_bench_start_stats.bus_active_ns) / bit_ns);
+	payload_bits = (uint32_t)bytes << 3;
+
+	bytes_per_s = 0;
+	if (elapsed_ns)
+		bytes_per_s = (uint32_t)(((uint64_t)bytes * 1000000000) / elapsed_ns);
+
+	if (unio_bench_result_count < UNIO_BENCH_MAX_RESULTS)
+	{
+		row = &unio_bench_results[unio_bench_result_count++];
+		row->operation = operation;
+		row->bytes = bytes;
+		row->bit_rate_hz = (uint32_t)(1000000000 / bit_ns);
+		row->result = result;
+		row->bus_bits = bus_bits;
+		row->elapsed_us = (uint32_t)(elapsed_ns / 1000);
+		row->int_disabled_max_us = (uint32_t)(unio_sim_stats.int_disabled_max_ns / 1000);
+	}
+
+	if (unio_bench_print)
+		printf("%s,%u,%lu,%u,%lu,%lu,%ld,%lu,%lu,%lu,%lu,%lu\n",
+			operation,
+			(unsigned int)bytes,
+			(unsigned long)(1000000000 / bit_ns),
+			(unsigned int)result,
+			(unsigned long)bus_bits,
+			(unsigned long)payload_bits,
+			(long)bus_bits - (long)payload_bits,
+			(unsigned long)(elapsed_ns / 1000),
+			(unsigned long)((unio_sim_stats.write_cycle_ns - unio_bench_start_stats.write_cycle_ns) / 1000),
+			(unsigned long)((unio_sim_stats.int_disabled_ns - unio_bench_start_stats.int_disabled_ns) / 1000),
+			(unsigned long)(unio_sim_stats.int_disabled_max_ns / 1000),
+			(unsigned long)bytes_per_s);
+
+	unio_sim_stats.int_disabled_max_ns = 0;			//(Longest per operation)
+}
@@ -0,0 +1,166 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name:	11LC010T EEPROM USING UNI/O 1 WIRE BUS - BENCHMARK
+
+
+
+//####################################
+//####################################
+//##### HOST SIMULATOR BENCHMARK #####
+//####################################
+//####################################
+//Runs each driver operation against the host simulator (mem-11lcxxx-sim.c) at several bus speeds and prints one CSV line per
+//operation and size, so results can be kept and compared between driver versions.
+//Columns:
+//	operation			standby, present, read, write or write_bulk
+//	bytes				Payload bytes
+//	bit_rate_hz			Bus speed the operation ran at
+//	result				Driver return value (1 = success)
+//	bus_bits			Bit periods on the wire (start header to end of each transaction, so 0 for standby)
+//	payload_bits		bytes x 8
+//	overhead_bits		bus_bits - payload_bits (start headers, address, command, MAK / SAK and write complete polling)
+//	elapsed_us			Total time the call took
+//	write_cycle_us		Time the device spent in internal write cycles
+//	int_disabled_us		Total time interrupts were disabled (needs the simulator DISABLE_INT / ENABLE_INT hooks, otherwise 0)
+//	int_disabled_max_us	Longest single interrupt disabled period
+//	bytes_per_s			Effective payload rate (bytes / elapsed_us)
+
+
+
+//##############################
+//##############################
+//##### USING IN A PROJECT #####
+//##############################
+//##############################
+/*
+	Define UNIO_HAL_HOST_SIM and compile mem-11lcxxx.c, mem-11lcxxx-sim.c and mem-11lcxxx-bench.c together, with in the host main.h:
+		#define	DISABLE_INT		unio_sim_disable_int()
+		#define	ENABLE_INT		unio_sim_enable_int()
+
+	int main (void)
+	{
+		unio_bench_run();			//CSV to stdout
+		return(0);
+	}
+
+	To catch regressions save the CSV as a baseline and compare later builds against it (test/Makefile "make bench" does this with
+	test/bench-baseline.csv):
+		if (!unio_bench_check("bench-baseline.csv", 5))		//Fails rows more than 5% slower than the baseline
+			return(1);
+*/
+
+
+
+//*****************************
+//*****************************
+//********** DEFINES **********
+//*****************************
+//*****************************
+#ifndef MEM_EXT_UNIO_BENCH_C_INIT		//(Do only once)
+#define	MEM_EXT_UNIO_BENCH_C_INIT
+
+#include "mem-11lcxxx.h"
+
+#ifndef UNIO_HAL_HOST_SIM
+#error mem-11lcxxx-bench.c needs the host simulator (define UNIO_HAL_HOST_SIM)
+#endif
+
+#define	UNIO_BENCH_QUARTER_PERIODS			{500, 250, 100, 50}		//Bus speeds to run at, in timer counts per quarter bit (10kHz, 20kHz, 50kHz, 100kHz)
+#define	UNIO_BENCH_READ_SIZES				{1, UNIO_EEPROM_PAGE_SIZE, UNIO_EEPROM_SIZE}
+#define	UNIO_BENCH_WRITE_SIZES				{1, UNIO_EEPROM_PAGE_SIZE}		//(Single page writes)
+#define	UNIO_BENCH_MAX_RESULTS				40			//Rows kept for unio_bench_check() (speeds x operations and sizes)
+
+
+typedef struct _UNIO_BENCH_RESULT
+{
+	const char *operation;
+	uint16_t bytes;
+	uint32_t bit_rate_hz;
+	BYTE result;
+	uint32_t bus_bits;
+	uint32_t elapsed_us;
+	uint32_t int_disabled_max_us;
+} UNIO_BENCH_RESULT;
+
+
+#endif
+
+
+
+//*******************************
+//*******************************
+//********** FUNCTIONS **********
+//*******************************
+//*******************************
+#ifdef MEM_EXT_UNIO_BENCH_C
+//-----------------------------------
+//----- INTERNAL ONLY FUNCTIONS -----
+//-----------------------------------
+void unio_bench_measure (void);
+void unio_bench_start (void);
+void unio_bench_report (const char *operation, uint16_t bytes, BYTE result);
+BYTE unio_bench_check_value (UNIO_BENCH_RESULT *row, const char *column, uint32_t value, uint32_t baseline, uint8_t threshold_percent);
+
+
+//-----------------------------------------
+//----- INTERNAL & EXTERNAL FUNCTIONS -----
+//-----------------------------------------
+//(Also defined below as extern)
+void unio_bench_run (void);
+BYTE unio_bench_check (const char *baseline_file, uint8_t threshold_percent);
+
+#else
+//------------------------------
+//----- EXTERNAL FUNCTIONS -----
+//------------------------------
+extern void unio_bench_run (void);
+extern BYTE unio_bench_check (const char *baseline_file, uint8_t threshold_percent);
+
+#endif
+
+
+
+
+//****************************
+//****************************
+//********** MEMORY **********
+//****************************
+//****************************
+#ifdef MEM_EXT_UNIO_BENCH_C
+//--------------------------------------------
+//----- INTERNAL ONLY MEMORY DEFINITIONS -----
+//--------------------------------------------
+UNIO_SIM_STATS unio_bench_start_stats;
+uint8_t unio_bench_data[UNIO_EEPROM_SIZE];
+UNIO_BENCH_RESULT unio_bench_results[UNIO_BENCH_MAX_RESULTS];
+uint8_t unio_bench_result_count;
+BYTE unio_bench_print;
+
+
+#endif
@@ -0,0 +1,230 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name: 11LC010T EEPROM USING UNI/O 1 WIRE BUS - WRITE BACK CACHE
+
+
+
+#include "main.h"					//Global data type definitions (see https://github.com/ibexuk/C_Generic_Header_File )
+
+
+#define	MEM_EXT_UNIO_CACHE_C		//(Our header file define)
+
+#include "mem-11lcxxx-cache.h"
+
+#if (UNIO_CACHE_SIZE > UNIO_EEPROM_SIZE)
+#error "UNIO_CACHE_SIZE is larger than the device selected in mem-11lcxxx.h"
+#endif
+
+
+//********************************
+//********************************
+//********** LOAD CACHE **********
+//********************************
+//********************************
+//Loads the cache from the device in a single sequential read.  Must be called (after unio_eeprom_init) before the cache is used, any
+//changes not yet flushed are discarded.
+//Returns:
+//	1 is sucessful, 0 if failed (the cache is not usable)
+BYTE unio_cache_load (void)
+{
+	uint8_t count;
+
+	unio_cache_loaded = 0;
+	for (count = 0; count < sizeof(unio_cache_dirty); count++)
+		unio_cache_dirty[count] = 0;
+	unio_cache_dirty_pages = 0;
+
+	if (!unio_eeprom_read(0x0000, &unio_cache_data[0], UNIO_CACHE_SIZE))
+		return(0);
+
+	unio_cache_loaded = 1;
+	return(1);
+}
+
+
+//********************************
+//********************************
+//********** CACHE READ **********
+//********************************
+//********************************
+//Returns:
+//	1 is sucessful, 0 if the cache is not loaded or the range is outside of the cache
+BYTE unio_cache_read (uint16_t address, uint8_t *data, uint16_t length)
+{
+	uint16_t count;
+
+	if ((!unio_cache_loaded) || (address >= UNIO_CACHE_SIZE) || (length > (UNIO_CACHE_SIZE - address)))
+		return(0);
+
+	for (count = 0; count < length; count++)
+		data[count] = unio_cache_data[address + count];
+	return(1);
+}
+
+
+//*********************************
+//*********************************
+//********** CACHE WRITE **********
+//*********************************
+//*********************************
+//Updates the cache only.  Pages with a byte that changed are marked dirty and the flush timer is started if nothing was dirty already.
+//Returns:
+//	1 is sucessful, 0 if the cache is not loaded or the range is outside of the cache
+BYTE unio_cache_write (uint16_t address, uint8_t *data, uint16_t length)
+{
+	uint16_t count;
+	uint8_t page;
+
+	if ((!unio_cache_loaded) || (address >= UNIO_CACHE_SIZE) || (length > (UNIO_CACHE_SIZE - address)))
+		return(0);
+
+	for (count = 0; count < length; count++, address++)
+	{
+		if (unio_cache_data[address] == data[count])
+			continue;
+
+		unio_cache_data[address] = data[count];
+		page = (uint8_t)(address / UNIO_EEPROM_PAGE_SIZE);
+		if (unio_cache_dirty[page >> 3] & (0x01 << (page & 0x07)))
+			continue;
+
+		if (!unio_cache_dirty_pages)
+			unio_cache_flush_timer = UNIO_CACHE_FLUSH_DELAY;		//First change - start the deadline
+		unio_cache_dirty[page >> 3] |= (uint8_t)(0x01 << (page & 0x07));
+		unio_cache_dirty_pages++;
+	}
+	return(1);
+}
+
+
+//***********************************
+//***********************************
+//********** CACHE PROCESS **********
+//***********************************
+//***********************************
+//Call from the main loop.  Once the flush deadline has passed, one dirty page is written per call so the main loop is never held up
+//for more than a single page write.
+void unio_cache_process (void)
+{
+	uint8_t page;
+
+	if (unio_cache_flush_timer)
+		return;
+
+	for (page = 0; page < UNIO_CACHE_PAGES; page++)
+	{
+		if (unio_cache_dirty[page >> 3] & (0x01 << (page & 0x07)))
+		{
+			if (!unio_cache_flush_page(page))
+				unio_cache_flush_timer = UNIO_CACHE_FLUSH_DELAY;		//Failed - try again later
+			return;
+		}
+	}
+}
+
+
+//*********************************
+//*********************************
+//********** CACHE FLUSH **********
+//*********************************
+//*********************************
+//Writes all dirty pages now (on demand or from a power fail warning).  Runs of adjacent dirty pages are written with a single bulk
+//write so they share one read back verify.
+//Returns:
+//	1 is sucessful (nothing left dirty), 0 if a page failed to write
+BYTE unio_cache_flush (void)
+{
+	uint8_t page;
+	uint8_t first_page;
+	UNIO_BULK_WRITE_RESULT result;
+	BYTE success = 1;
+
+	page = 0;
+	while (page < UNIO_CACHE_PAGES)
+	{
+		if (!(unio_cache_dirty[page >> 3] & (0x01 << (page & 0x07))))
+		{
+			page++;
+			continue;
+		}
+
+		//----- FIND THE RUN OF DIRTY PAGES -----
+		first_page = page;
+		while ((page < UNIO_CACHE_PAGES) && (unio_cache_dirty[page >> 3] & (0x01 << (page & 0x07))))
+			page++;
+
+		if (!unio_eeprom_write_bulk((uint16_t)first_page * UNIO_EEPROM_PAGE_SIZE, &unio_cache_data[(uint16_t)first_page * UNIO_EEPROM_PAGE_SIZE],
+									(uint16_t)(page - first_page) * UNIO_EEPROM_PAGE_SIZE, &result))
+		{
+			success = 0;
+		}
+		else
+		{
+			unio_cache_dirty_pages -= (uint8_t)(page - first_page);
+			for ( ; first_page < page; first_page++)
+				unio_cache_dirty[first_page >> 3] &= (uint8_t)~(0x01 << (first_page & 0x07));
+		}
+		unio_cache_page_writes += result.pages_written;
+	}
+	return(success);
+}
+
+
+//**************************************
+//**************************************
+//********** CACHE FLUSH PAGE **********
+//**************************************
+//**************************************
+BYTE unio_cache_flush_page (uint8_t page)
+{
+	uint8_t result;
+
+	result = unio_eeprom_write_report(((uint16_t)page * UNIO_EEPROM_PAGE_SIZE), &unio_cache_data[(uint16_t)page * UNIO_EEPROM_PAGE_SIZE], UNIO_EEPROM_PAGE_SIZE);
+	if (result == UNIO_WRITE_FAILED)
+		return(0);
+
+	if (result == UNIO_WRITE_DONE)
+		unio_cache_page_writes++;				//(Not if UNIO_WRITE_SKIP_UNCHANGED found the page already the same)
+	unio_cache_dirty[page >> 3] &= (uint8_t)~(0x01 << (page & 0x07));
+	unio_cache_dirty_pages--;
+	return(1);
+}
+
+
+//***************************************
+//***************************************
+//********** CACHE DIRTY COUNT **********
+//***************************************
+//***************************************
+//Returns:
+//	Number of pages waiting to be written
+uint8_t unio_cache_dirty_count (void)
+{
+	return(unio_cache_dirty_pages);
+}
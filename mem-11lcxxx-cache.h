@@ -0,0 +1,172 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name:	11LC010T EEPROM USING UNI/O 1 WIRE BUS - WRITE BACK CACHE
+
+
+
+//###########################
+//###########################
+//##### WRITE BACK CACHE #####
+//###########################
+//###########################
+//A RAM mirror of the EEPROM for values that are updated often (counters, settings etc).
+//- The whole device is loaded with a single sequential read.  Reads are then served from RAM.
+//- Writes only update RAM.  Each 16 byte page that actually changed is marked dirty (writing the same value again costs nothing).
+//- Dirty pages are programmed later, so many small updates to a page cost a single page write cycle:
+//		By deadline		unio_cache_process() from the main loop, once unio_cache_flush_timer has counted down after the first change
+//		On demand		unio_cache_flush()
+//		Power fail		unio_cache_flush() from the power fail warning (allow approx 1 page write per dirty page)
+//Writes made directly with unio_eeprom_write() etc bypass the cache, so once the cache is in use all access to the cached range
+//should go through it.
+
+
+
+//##############################
+//##############################
+//##### USING IN A PROJECT #####
+//##############################
+//##############################
+/*
+	//----- INITIALISE -----
+	unio_eeprom_init();
+	if (!unio_cache_load())
+	{
+		//EEPROM NOT PRESENT / READ FAILED
+		Nop();
+	}
+
+	//----- IN YOUR HEARTBEAT TIMER -----
+	if (unio_cache_flush_timer)
+		unio_cache_flush_timer--;
+
+	//----- IN YOUR MAIN LOOP -----
+	unio_cache_process();
+
+	//----- ACCESSING VALUES -----
+	uint32_t counter;
+	unio_cache_read(UNIO_EEPROM_VALUE_0, (uint8_t*)&counter, sizeof(counter));
+	counter++;
+	unio_cache_write(UNIO_EEPROM_VALUE_0, (uint8_t*)&counter, sizeof(counter));
+
+	//----- POWER FAIL WARNING -----
+	unio_cache_flush();
+*/
+
+
+
+//*****************************
+//*****************************
+//********** DEFINES **********
+//*****************************
+//*****************************
+#ifndef MEM_EXT_UNIO_CACHE_C_INIT		//(Do only once)
+#define	MEM_EXT_UNIO_CACHE_C_INIT
+
+#include "mem-11lcxxx.h"
+
+#define	UNIO_CACHE_SIZE						128			//Bytes of the device to mirror from address 0x0000 (must be a multiple of UNIO_EEPROM_PAGE_SIZE)
+#define	UNIO_CACHE_FLUSH_DELAY				1000		//Heartbeat periods from the first change until dirty pages are written by unio_cache_process()
+
+#define	UNIO_CACHE_PAGES					(UNIO_CACHE_SIZE / UNIO_EEPROM_PAGE_SIZE)
+
+
+#endif
+
+
+//*******************************
+//*******************************
+//********** FUNCTIONS **********
+//*******************************
+//*******************************
+#ifdef MEM_EXT_UNIO_CACHE_C
+//-----------------------------------
+//----- INTERNAL ONLY FUNCTIONS -----
+//-----------------------------------
+BYTE unio_cache_flush_page (uint8_t page);
+
+
+//-----------------------------------------
+//----- INTERNAL & EXTERNAL FUNCTIONS -----
+//-----------------------------------------
+//(Also defined below as extern)
+BYTE unio_cache_load (void);
+BYTE unio_cache_read (uint16_t address, uint8_t *data, uint16_t length);
+BYTE unio_cache_write (uint16_t address, uint8_t *data, uint16_t length);
+void unio_cache_process (void);
+BYTE unio_cache_flush (void);
+uint8_t unio_cache_dirty_count (void);
+
+#else
+//------------------------------
+//----- EXTERNAL FUNCTIONS -----
+//------------------------------
+extern BYTE unio_cache_load (void);
+extern BYTE unio_cache_read (uint16_t address, uint8_t *data, uint16_t length);
+extern BYTE unio_cache_write (uint16_t address, uint8_t *data, uint16_t length);
+extern void unio_cache_process (void);
+extern BYTE unio_cache_flush (void);
+extern uint8_t unio_cache_dirty_count (void);
+
+#endif
+
+
+
+
+//****************************
+//****************************
+//********** MEMORY **********
+//****************************
+//****************************
+#ifdef MEM_EXT_UNIO_CACHE_C
+//--------------------------------------------
+//----- INTERNAL ONLY MEMORY DEFINITIONS -----
+//--------------------------------------------
+uint8_t unio_cache_data[UNIO_CACHE_SIZE];
+uint8_t unio_cache_dirty[(UNIO_CACHE_PAGES + 7) >> 3];			//Bit per page
+uint8_t unio_cache_dirty_pages;					//Bits set in unio_cache_dirty
+uint8_t unio_cache_loaded;
+
+
+//--------------------------------------------------
+//----- INTERNAL & EXTERNAL MEMORY DEFINITIONS -----
+//--------------------------------------------------
+//(Also defined below as extern)
+volatile uint16_t unio_cache_flush_timer;		//Decrement in your heartbeat timer (see UNIO_CACHE_FLUSH_DELAY)
+uint16_t unio_cache_page_writes;				//Page write cycles used by flushes (for monitoring)
+
+
+#else
+//---------------------------------------
+//----- EXTERNAL MEMORY DEFINITIONS -----
+//---------------------------------------
+extern volatile uint16_t unio_cache_flush_timer;
+extern uint16_t unio_cache_page_writes;
+
+
+#endif
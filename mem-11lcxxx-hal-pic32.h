@@ -0,0 +1,78 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name:	11LC010T EEPROM USING UNI/O 1 WIRE BUS - PIC32 HAL
+
+
+
+//######################################
+//######################################
+//##### PIC32 HARDWARE ABSTRACTION #####
+//######################################
+//######################################
+//SCIO pin and timer macros for PIC32 (SCIO on RE2, timer 2), included by mem-11lcxxx.h when neither UNIO_HAL_HEADER nor
+//UNIO_HAL_HOST_SIM is defined.  To port the driver copy this file, change the macros for your device and define UNIO_HAL_HEADER as
+//its name for the project - mem-11lcxxx.h stops with an #error if any of the required macros are missing.  Keep them as macros or
+//static inline expressions, they are used inside the quarter bit timing loops.
+//UNIO_MULTI_SCIO_ and UNIO_SCIO_CAPTURE_ macros are only needed for the multi bus engine and the edge decoder.
+
+
+
+//*****************************
+//*****************************
+//********** DEFINES **********
+//*****************************
+//*****************************
+#ifndef MEM_EXT_UNIO_HAL_PIC32_INIT		//(Do only once)
+#define	MEM_EXT_UNIO_HAL_PIC32_INIT
+
+#define	UNIO_SCIO_TRIS(data)					(data ? mPORTESetPinsDigitalIn(0x0004) : mPORTESetPinsDigitalOut(0x0004))
+#define	UNIO_SCIO_OUTPUT(data)					(data ? mPORTESetBits(0x0004) : mPORTEClearBits(0x0004))
+#define	UNIO_SCIO_INPUT							mPORTEReadBits(BIT_2)
+#define	UNIO_EEPROM_CLEAR_IRQ_FLAG()			INTClearFlag(INT_T2)
+#define	UNIO_EEPROM_READ_IRQ_FLAG()				INTGetFlag(INT_T2)
+#define	UNIO_EEPROM_WRITE_TIMER(data)			WriteTimer2(data)
+#define	UNIO_EEPROM_OPEN_TIMER(period)			OpenTimer2((T2_ON | T2_IDLE_CON | T2_GATE_OFF | T2_PS_1_1 | T2_SOURCE_INT), (uint16_t)(period))		//<<SET PRx VALUE TO GIVE #uS ROLL OVER AND SETTING OF IRQ FLAG
+#define	UNIO_EEPROM_TIMER_QUARTER_PERIOD		500		//2.5uS - 25uS to give 10kHz to 100kHz.  Our 20Mhz peripheral bus clock = 50nS.  2.5uS / 50nS = 50.  25uS / 50nS = 500
+														//You must ensure bit timing it complelty accurate, make slower if there is risk of fucntion calls etc being too slow for bitrate you have set.
+														//(This is the default and slowest speed, see unio_calibrate_bus_speed())
+#define	UNIO_EEPROM_TIMER_MIN_QUARTER_PERIOD	((250000 / UNIO_EEPROM_MAX_BUS_KHZ) / UNIO_EEPROM_TIMER_COUNT_NS)		//Fastest speed unio_set_bus_speed() will allow (50 = 2.5uS = 100kHz)
+#define	UNIO_EEPROM_TIMER_COUNT_NS				50		//Timer clock period in nS (only used to convert unio_bus_ticks to time)
+#define	UNIO_EEPROM_ENABLE_TIMER_IRQ()			INTEnable(INT_T2, INT_ENABLED)		//Interrupt driven engine or shared timer only
+#define	UNIO_EEPROM_DISABLE_TIMER_IRQ()			INTEnable(INT_T2, INT_DISABLED)
+#define	UNIO_EEPROM_IDLE_WAIT()										//Called while blocking functions wait for the interrupt driven engine (e.g. ClearWDT())
+#define	UNIO_MULTI_SCIO_TRIS(input_mask)		(TRISESET = ((input_mask) << UNIO_MULTI_SCIO_SHIFT) & UNIO_MULTI_SCIO_MASK, TRISECLR = (~(input_mask) << UNIO_MULTI_SCIO_SHIFT) & UNIO_MULTI_SCIO_MASK)		//Multi bus engine only
+#define	UNIO_MULTI_SCIO_OUTPUT(levels)			(LATE = (LATE & ~UNIO_MULTI_SCIO_MASK) | (((levels) << UNIO_MULTI_SCIO_SHIFT) & UNIO_MULTI_SCIO_MASK))		//All buses in a single port write
+#define	UNIO_MULTI_SCIO_INPUT					(PORTE >> UNIO_MULTI_SCIO_SHIFT)		//All buses in a single port read
+#define	UNIO_MULTI_SCIO_SHIFT					8		//Bus 0 is RE8, bus 1 RE9 etc
+#define	UNIO_SCIO_CAPTURE_OPEN()				OpenCapture1(IC_EVERY_EDGE | IC_INT_1CAPTURE | IC_TIMER2_SRC | IC_CAP_16BIT | IC_ON)		//<<IC1 PIN MUST BE THE SCIO PIN (edge decoder only)
+#define	UNIO_SCIO_CAPTURE_READ()				(mIC1CaptureReady() ? (uint16_t)mIC1ReadCapture() : UNIO_SCIO_NO_CAPTURE)		//Oldest edge first
+
+
+
+#endif
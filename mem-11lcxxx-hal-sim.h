@@ -0,0 +1,75 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name:	11LC010T EEPROM USING UNI/O 1 WIRE BUS - HOST SIMULATOR HAL
+
+
+
+//###############################################
+//###############################################
+//##### HOST SIMULATOR HARDWARE ABSTRACTION #####
+//###############################################
+//###############################################
+//SCIO pin and timer macros that connect the driver to the simulated 11LCxxx and virtual timer in mem-11lcxxx-sim.c, included by
+//mem-11lcxxx.h when UNIO_HAL_HOST_SIM is defined.
+
+
+
+//*****************************
+//*****************************
+//********** DEFINES **********
+//*****************************
+//*****************************
+#ifndef MEM_EXT_UNIO_HAL_SIM_INIT		//(Do only once)
+#define	MEM_EXT_UNIO_HAL_SIM_INIT
+
+#include "mem-11lcxxx-sim.h"
+
+#define	UNIO_SCIO_TRIS(data)					unio_sim_scio_tris(data)
+#define	UNIO_SCIO_OUTPUT(data)					unio_sim_scio_output(data)
+#define	UNIO_SCIO_INPUT							unio_sim_scio_input()
+#define	UNIO_EEPROM_CLEAR_IRQ_FLAG()			unio_sim_clear_irq_flag()
+#define	UNIO_EEPROM_READ_IRQ_FLAG()				unio_sim_read_irq_flag()
+#define	UNIO_EEPROM_WRITE_TIMER(data)			unio_sim_write_timer(data)
+#define	UNIO_EEPROM_OPEN_TIMER(period)			unio_sim_open_timer(period)
+#define	UNIO_EEPROM_TIMER_QUARTER_PERIOD		500		//Virtual timer counts of UNIO_SIM_TIMER_COUNT_NS (50nS), so same bus speed as the PIC32 setting (mem-11lcxxx-hal-pic32.h)
+#define	UNIO_EEPROM_TIMER_MIN_QUARTER_PERIOD	((250000 / UNIO_EEPROM_MAX_BUS_KHZ) / UNIO_EEPROM_TIMER_COUNT_NS)		//(50 = 2.5uS = 100kHz)
+#define	UNIO_EEPROM_TIMER_COUNT_NS				UNIO_SIM_TIMER_COUNT_NS
+#define	UNIO_EEPROM_ENABLE_TIMER_IRQ()			unio_sim_enable_timer_irq(unio_timer_isr)
+#define	UNIO_EEPROM_DISABLE_TIMER_IRQ()			unio_sim_enable_timer_irq(0)
+#define	UNIO_EEPROM_IDLE_WAIT()					unio_sim_idle_wait()
+#define	UNIO_MULTI_SCIO_TRIS(input_mask)		unio_sim_port_tris(input_mask)
+#define	UNIO_MULTI_SCIO_OUTPUT(levels)			unio_sim_port_output(levels)
+#define	UNIO_MULTI_SCIO_INPUT					unio_sim_port_input()
+#define	UNIO_MULTI_SCIO_SHIFT					0		//Bus 0 is port bit 0 (unio_sim_devices[0])
+#define	UNIO_SCIO_CAPTURE_OPEN()
+#define	UNIO_SCIO_CAPTURE_READ()				unio_sim_capture_read()
+
+
+
+#endif
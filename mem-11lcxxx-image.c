@@ -0,0 +1,375 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name:	11LC010T EEPROM USING UNI/O 1 WIRE BUS - IMAGE DUMP, RESTORE & SYNC
+
+
+
+#include "main.h"					//Global data type definitions (see https://github.com/ibexuk/C_Generic_Header_File )
+#ifdef UNIO_HAL_HOST_SIM
+#include <stdio.h>
+#include <string.h>
+#endif
+
+
+#define	MEM_EXT_UNIO_IMAGE_C		//(Our header file define)
+
+#include "mem-11lcxxx-image.h"
+
+#if ((UNIO_IMAGE_CHUNK_SIZE % UNIO_EEPROM_PAGE_SIZE) || (UNIO_IMAGE_CHUNK_SIZE & (UNIO_IMAGE_CHUNK_SIZE - 1)))
+#error "UNIO_IMAGE_CHUNK_SIZE must be a power of 2 multiple of UNIO_EEPROM_PAGE_SIZE"
+#endif
+
+
+//********************************
+//********************************
+//********** IMAGE DUMP **********
+//********************************
+//********************************
+//Reads the whole device (UNIO_EEPROM_SIZE bytes) in a single sequential read.
+//Returns:
+//	1 is sucessful, 0 if failed
+BYTE unio_image_dump (uint8_t *image)
+{
+	return(unio_eeprom_read(0x0000, image, UNIO_EEPROM_SIZE));
+}
+
+
+//********************************
+//********************************
+//********** IMAGE DIFF **********
+//********************************
+//********************************
+//Compares two whole device images.  changed_pages (optional, may be null) is loaded with a bit per page (UNIO_IMAGE_PAGES bits,
+//page 0 is bit 0 of byte 0), set if the page differs.
+//Returns:
+//	Number of pages that differ
+uint16_t unio_image_diff (uint8_t *image_a, uint8_t *image_b, uint8_t *changed_pages)
+{
+	uint16_t page;
+	uint16_t address;
+	uint8_t count;
+	uint16_t changed_count = 0;
+
+	for (page = 0; page < UNIO_IMAGE_PAGES; page++)
+	{
+		if (changed_pages)
+			changed_pages[page >> 3] &= (uint8_t)~(0x01 << (page & 0x07));
+
+		address = page * UNIO_EEPROM_PAGE_SIZE;
+		for (count = 0; count < UNIO_EEPROM_PAGE_SIZE; count++)
+		{
+			if (image_a[address + count] != image_b[address + count])
+				break;
+		}
+		if (count < UNIO_EEPROM_PAGE_SIZE)
+		{
+			changed_count++;
+			if (changed_pages)
+				changed_pages[page >> 3] |= (uint8_t)(0x01 << (page & 0x07));
+		}
+	}
+	return(changed_count);
+}
+
+
+//********************************
+//********************************
+//********** IMAGE SYNC **********
+//********************************
+//********************************
+//Makes the device range address to (address + length - 1) match image, writing only the pages that differ.  The device is read
+//UNIO_IMAGE_CHUNK_SIZE bytes at a time and each run of changed pages is written with unio_eeprom_write_bulk() (verified as set by
+//unio_verify_policy).  Unaligned first and last pages are compared and written as partial pages.
+//result (optional, may be null) is loaded with the pages compared, changed and written and the bus time taken.
+//Returns:
+//	1 is sucessful, 0 if failed or the range is past the end of the device
+BYTE unio_image_sync (uint16_t address, uint8_t *image, uint16_t length, UNIO_IMAGE_RESULT *result)
+{
+	uint16_t offset = 0;
+	uint16_t chunk_length;
+	uint16_t chunk_offset;
+	uint16_t page_length;
+	uint16_t run_offset = 0;
+	uint16_t run_length = 0;
+	uint16_t count;
+	uint16_t pages_compared = 0;
+	uint16_t pages_changed = 0;
+	uint16_t pages_written = 0;
+	uint32_t start_ticks = unio_bus_ticks;
+	UNIO_BULK_WRITE_RESULT write_result;
+	BYTE success = 1;
+
+
+	if (((uint32_t)address + length) > UNIO_EEPROM_SIZE)
+	{
+		success = 0;
+		length = 0;
+	}
+
+	while (offset < length)
+	{
+		//----- READ THE NEXT CHUNK -----
+		chunk_length = UNIO_IMAGE_CHUNK_SIZE - ((address + offset) & (UNIO_IMAGE_CHUNK_SIZE - 1));		//(Chunks are aligned so a page is never split between two)
+		if (chunk_length > (length - offset))
+			chunk_length = length - offset;
+
+		if (!unio_eeprom_read((address + offset), &unio_image_buffer[0], chunk_length))
+		{
+			success = 0;
+			break;
+		}
+
+		//----- COMPARE EACH PAGE IN THE CHUNK -----
+		chunk_offset = 0;
+		while (chunk_offset < chunk_length)
+		{
+			page_length = UNIO_EEPROM_PAGE_SIZE - ((address + offset) & (UNIO_EEPROM_PAGE_SIZE - 1));
+			if (page_length > (chunk_length - chunk_offset))
+				page_length = chunk_length - chunk_offset;
+
+			pages_compared++;
+			for (count = 0; count < page_length; count++)
+			{
+				if (unio_image_buffer[chunk_offset + count] != image[offset + count])
+					break;
+			}
+
+			if (count < page_length)
+			{
+				//Page differs - add it to the run
+				pages_changed++;
+				if (!run_length)
+					run_offset = offset;
+				run_length += page_length;
+			}
+			else if (run_length)
+			{
+				//Page matches - write the run before it
+				if (!unio_eeprom_write_bulk((address + run_offset), &image[run_offset], run_length, &write_result))
+					success = 0;
+				pages_written += write_result.pages_written;
+				run_length = 0;
+			}
+
+			chunk_offset += page_length;
+			offset += page_length;
+		}
+	}
+
+	//----- WRITE THE LAST RUN -----
+	if (run_length)
+	{
+		if (!unio_eeprom_write_bulk((address + run_offset), &image[run_offset], run_length, &write_result))
+			success = 0;
+		pages_written += write_result.pages_written;
+	}
+
+	if (result)
+	{
+		result->pages_compared = pages_compared;
+		result->pages_changed = pages_changed;
+		result->pages_written = pages_written;
+		result->bus_ticks = unio_bus_ticks - start_ticks;
+	}
+	return(success);
+}
+
+
+
+#ifdef UNIO_HAL_HOST_SIM
+//********************************
+//********************************
+//********** IMAGE TOOL **********
+//********************************
+//********************************
+//Host command line tool (see the header file).  Runs against the simulated device at the default bus speed.
+//Returns:
+//	Process exit code - 0 if sucessful, 1 if diff found differences or the operation failed, 2 for a usage or file error
+int unio_image_tool (int argc, char **argv)
+{
+	const char *device_file = 0;
+	const char *command;
+	const char *image_file;
+	FILE *file;
+	UNIO_IMAGE_RESULT result;
+	UNIO_BULK_WRITE_RESULT write_result;
+	uint16_t page;
+	int arg = 1;
+	BYTE success;
+
+
+	if ((argc > (arg + 1)) && (strcmp(argv[arg], "-d") == 0))
+	{
+		device_file = argv[arg + 1];
+		arg += 2;
+	}
+	if (argc != (arg + 2))
+	{
+		fprintf(stderr, "usage: %s [-d device.bin] dump|diff|sync|restore image.bin\n", argv[0]);
+		return(2);
+	}
+	command = argv[arg];
+	image_file = argv[arg + 1];
+
+	//----- POWER ON THE SIMULATED DEVICE -----
+	unio_sim_reset();
+	unio_sim_device.size = UNIO_EEPROM_SIZE;
+	if (device_file)
+	{
+		file = fopen(device_file, "rb");
+		if (file)
+		{
+			fclose(file);
+			if (!unio_image_read_file(device_file, &unio_sim_device.memory[0]))
+				return(2);
+		}
+		//(Else a new blank device)
+	}
+	unio_set_bus_speed(UNIO_EEPROM_TIMER_QUARTER_PERIOD);
+	unio_eeprom_init();
+
+	if (strcmp(command, "dump") == 0)
+	{
+		//----- DUMP -----
+		if (!unio_image_dump(&unio_image_device[0]))
+		{
+			fprintf(stderr, "read failed\n");
+			return(1);
+		}
+		if (!unio_image_write_file(image_file, &unio_image_device[0]))
+			return(2);
+		printf("dumped %u bytes\n", (unsigned int)UNIO_EEPROM_SIZE);
+		return(0);
+	}
+
+	if (!unio_image_read_file(image_file, &unio_image_target[0]))
+		return(2);
+
+	if (strcmp(command, "diff") == 0)
+	{
+		//----- DIFF -----
+		if (!unio_image_dump(&unio_image_device[0]))
+		{
+			fprintf(stderr, "read failed\n");
+			return(1);
+		}
+		result.pages_changed = unio_image_diff(&unio_image_device[0], &unio_image_target[0], &unio_image_changed[0]);
+		for (page = 0; page < UNIO_IMAGE_PAGES; page++)
+		{
+			if (unio_image_changed[page >> 3] & (0x01 << (page & 0x07)))
+				printf("0x%04x\n", (unsigned int)(page * UNIO_EEPROM_PAGE_SIZE));
+		}
+		printf("%u of %u pages differ\n", (unsigned int)result.pages_changed, (unsigned int)UNIO_IMAGE_PAGES);
+		return(result.pages_changed ? 1 : 0);
+	}
+	else if (strcmp(command, "sync") == 0)
+	{
+		//----- SYNC -----
+		success = unio_image_sync(0x0000, &unio_image_target[0], UNIO_EEPROM_SIZE, &result);
+		printf("%u of %u pages changed, %u page writes, %lu us\n", (unsigned int)result.pages_changed, (unsigned int)result.pages_compared,
+				(unsigned int)result.pages_written, (unsigned long)UNIO_EEPROM_TICKS_TO_US(result.bus_ticks));
+	}
+	else if (strcmp(command, "restore") == 0)
+	{
+		//----- RESTORE -----
+		success = unio_eeprom_write_bulk(0x0000, &unio_image_target[0], UNIO_EEPROM_SIZE, &write_result);
+		printf("%u page writes, %lu us\n", (unsigned int)write_result.pages_written, (unsigned long)UNIO_EEPROM_TICKS_TO_US(write_result.bus_ticks));
+	}
+	else
+	{
+		fprintf(stderr, "unknown command %s\n", command);
+		return(2);
+	}
+
+	if (!success)
+		fprintf(stderr, "write failed\n");
+	if ((device_file) && (!unio_image_write_file(device_file, &unio_sim_device.memory[0])))
+		return(2);
+	return(success ? 0 : 1);
+}
+
+
+//*************************************
+//*************************************
+//********** READ IMAGE FILE **********
+//*************************************
+//*************************************
+//The file must be exactly UNIO_EEPROM_SIZE bytes.
+//Returns:
+//	1 is sucessful, 0 if failed (reported on stderr)
+BYTE unio_image_read_file (const char *filename, uint8_t *image)
+{
+	FILE *file;
+	size_t length;
+
+	file = fopen(filename, "rb");
+	if (!file)
+	{
+		fprintf(stderr, "can't open %s\n", filename);
+		return(0);
+	}
+	length = fread(image, 1, UNIO_EEPROM_SIZE, file);
+	if ((length != UNIO_EEPROM_SIZE) || (fgetc(file) != EOF))
+	{
+		fclose(file);
+		fprintf(stderr, "%s is not a %u byte image\n", filename, (unsigned int)UNIO_EEPROM_SIZE);
+		return(0);
+	}
+	fclose(file);
+	return(1);
+}
+
+
+//**************************************
+//**************************************
+//********** WRITE IMAGE FILE **********
+//**************************************
+//**************************************
+//Returns:
+//	1 is sucessful, 0 if failed (reported on stderr)
+BYTE unio_image_write_file (const char *filename, uint8_t *image)
+{
+	FILE *file;
+	size_t length;
+
+	file = fopen(filename, "wb");
+	if (!file)
+	{
+		fprintf(stderr, "can't create %s\n", filename);
+		return(0);
+	}
+	length = fwrite(image, 1, UNIO_EEPROM_SIZE, file);
+	if ((fclose(file) != 0) || (length != UNIO_EEPROM_SIZE))
+	{
+		fprintf(stderr, "can't write %s\n", filename);
+		return(0);
+	}
+	return(1);
+}
+#endif
@@ -0,0 +1,166 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name:	11LC010T EEPROM USING UNI/O 1 WIRE BUS - IMAGE DUMP, RESTORE & SYNC
+
+
+
+//######################################
+//######################################
+//##### IMAGE DUMP, RESTORE & SYNC #####
+//######################################
+//######################################
+//Whole device images for production programming and field updates.
+//- unio_image_dump() reads the whole device in a single sequential read.
+//- unio_image_diff() compares two images page by page.
+//- unio_image_sync() programs only the pages of a target image that differ from the device, so a device that already holds most of
+//  the image (re-programming on the line, a field update that changes a few settings) costs a page write cycle per changed page
+//  rather than per page.  The device is compared in UNIO_IMAGE_CHUNK_SIZE sequential reads (the only RAM used) and each run of
+//  changed pages is written with a single unio_eeprom_write_bulk(), so the run shares one verify read (see unio_verify_policy).
+//These run on target or against the host simulator.  On the host unio_image_tool() adds a command line tool that works on a
+//simulated device, optionally backed by a file so the device contents persist between runs.
+
+
+
+//##############################
+//##############################
+//##### USING IN A PROJECT #####
+//##############################
+//##############################
+/*
+	//----- FIELD UPDATE -----
+	UNIO_IMAGE_RESULT result;
+
+	if (!unio_image_sync(0x0000, &new_settings[0], sizeof(new_settings), &result))
+		Nop();							//FAILED
+	//result.pages_changed pages needed writing
+
+	//----- HOST COMMAND LINE TOOL -----
+	//Define UNIO_HAL_HOST_SIM and compile mem-11lcxxx.c, mem-11lcxxx-sim.c and mem-11lcxxx-image.c together with:
+	int main (int argc, char **argv)
+	{
+		return(unio_image_tool(argc, argv));
+	}
+	//(test/mem-11lcxxx-image-tool.c, "make image-tool" in test/ builds it as test/build/unio_image_tool)
+	//Then:
+	//	tool [-d device.bin] dump image.bin			Read the device to a file
+	//	tool [-d device.bin] diff image.bin			List the pages that differ (exit code 1 if any)
+	//	tool [-d device.bin] sync image.bin			Program only the pages that differ
+	//	tool [-d device.bin] restore image.bin		Program every page
+	//-d device.bin is the simulated device's contents, loaded before (a blank device if the file doesn't exist yet) and saved after.
+*/
+
+
+
+//*****************************
+//*****************************
+//********** DEFINES **********
+//*****************************
+//*****************************
+#ifndef MEM_EXT_UNIO_IMAGE_C_INIT		//(Do only once)
+#define	MEM_EXT_UNIO_IMAGE_C_INIT
+
+#include "mem-11lcxxx.h"
+
+#define	UNIO_IMAGE_CHUNK_SIZE				64			//Bytes compared per sequential read by unio_image_sync() (RAM used, must be a power of 2 multiple of UNIO_EEPROM_PAGE_SIZE)
+
+#define	UNIO_IMAGE_PAGES					(UNIO_EEPROM_SIZE / UNIO_EEPROM_PAGE_SIZE)
+
+
+typedef struct _UNIO_IMAGE_RESULT
+{
+	uint16_t pages_compared;
+	uint16_t pages_changed;				//Pages that differed from the target image
+	uint16_t pages_written;				//Page write cycles used (including retries)
+	uint32_t bus_ticks;					//Quarter bit periods taken (UNIO_EEPROM_TICKS_TO_US() to convert)
+} UNIO_IMAGE_RESULT;
+
+
+#endif
+
+
+//*******************************
+//*******************************
+//********** FUNCTIONS **********
+//*******************************
+//*******************************
+#ifdef MEM_EXT_UNIO_IMAGE_C
+//-----------------------------------
+//----- INTERNAL ONLY FUNCTIONS -----
+//-----------------------------------
+#ifdef UNIO_HAL_HOST_SIM
+BYTE unio_image_read_file (const char *filename, uint8_t *image);
+BYTE unio_image_write_file (const char *filename, uint8_t *image);
+#endif
+
+
+//-----------------------------------------
+//----- INTERNAL & EXTERNAL FUNCTIONS -----
+//-----------------------------------------
+//(Also defined below as extern)
+BYTE unio_image_dump (uint8_t *image);
+uint16_t unio_image_diff (uint8_t *image_a, uint8_t *image_b, uint8_t *changed_pages);
+BYTE unio_image_sync (uint16_t address, uint8_t *image, uint16_t length, UNIO_IMAGE_RESULT *result);
+#ifdef UNIO_HAL_HOST_SIM
+int unio_image_tool (int argc, char **argv);
+#endif
+
+#else
+//------------------------------
+//----- EXTERNAL FUNCTIONS -----
+//------------------------------
+extern BYTE unio_image_dump (uint8_t *image);
+extern uint16_t unio_image_diff (uint8_t *image_a, uint8_t *image_b, uint8_t *changed_pages);
+extern BYTE unio_image_sync (uint16_t address, uint8_t *image, uint16_t length, UNIO_IMAGE_RESULT *result);
+#ifdef UNIO_HAL_HOST_SIM
+extern int unio_image_tool (int argc, char **argv);
+#endif
+
+#endif
+
+
+
+
+//****************************
+//****************************
+//********** MEMORY **********
+//****************************
+//****************************
+#ifdef MEM_EXT_UNIO_IMAGE_C
+//--------------------------------------------
+//----- INTERNAL ONLY MEMORY DEFINITIONS -----
+//--------------------------------------------
+uint8_t unio_image_buffer[UNIO_IMAGE_CHUNK_SIZE];
+#ifdef UNIO_HAL_HOST_SIM
+uint8_t unio_image_device[UNIO_EEPROM_SIZE];
+uint8_t unio_image_target[UNIO_EEPROM_SIZE];
+uint8_t unio_image_changed[(UNIO_IMAGE_PAGES + 7) >> 3];
+#endif
+
+
+#endif
@@ -0,0 +1,269 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name: 11LC010T EEPROM USING UNI/O 1 WIRE BUS - WEAR LEVELLED KEY / VALUE STORE
+
+
+
+#include "main.h"					//Global data type definitions (see https://github.com/ibexuk/C_Generic_Header_File )
+#include <string.h>
+
+
+#define	MEM_EXT_UNIO_KV_C			//(Our header file define)
+
+#include "mem-11lcxxx-kv.h"
+
+#if (((UNIO_KV_START_PAGE + UNIO_KV_PAGES) * UNIO_EEPROM_PAGE_SIZE) > UNIO_EEPROM_SIZE)
+#error "UNIO_KV_START_PAGE / UNIO_KV_PAGES are past the end of the device selected in mem-11lcxxx.h"
+#endif
+
+
+//************************************
+//************************************
+//********** MOUNT KV STORE **********
+//************************************
+//************************************
+//Reads the whole store in sequential reads of UNIO_KV_SCAN_PAGES pages and builds the RAM index from the newest valid record of each key.
+//Must be called (after unio_eeprom_init) before the store is used.
+//Returns:
+//	1 is sucessful, 0 if the device could not be read
+BYTE unio_kv_mount (void)
+{
+	uint8_t page;
+	uint8_t scan_pages;
+	uint8_t index;
+	uint8_t *record;
+	uint8_t key;
+	uint16_t sequence;
+	uint16_t newest_sequence = 0;
+	uint8_t found = 0;
+
+	unio_kv_mounted = 0;
+	unio_kv_head = 0;
+	for (key = 0; key < UNIO_KV_MAX_KEYS; key++)
+		unio_kv_index[key].page = UNIO_KV_NO_PAGE;
+
+	for (page = 0; page < UNIO_KV_PAGES; page += scan_pages)
+	{
+		scan_pages = UNIO_KV_SCAN_PAGES;
+		if (scan_pages > (UNIO_KV_PAGES - page))
+			scan_pages = UNIO_KV_PAGES - page;
+
+		if (!unio_eeprom_read(((uint16_t)(UNIO_KV_START_PAGE + page) * UNIO_EEPROM_PAGE_SIZE), &unio_kv_buffer[0], ((uint16_t)scan_pages * UNIO_EEPROM_PAGE_SIZE)))
+			return(0);
+
+		for (index = 0; index < scan_pages; index++)
+		{
+			//----- CHECK RECORD -----
+			record = &unio_kv_buffer[(uint16_t)index * UNIO_EEPROM_PAGE_SIZE];
+			key = record[0];
+			if ((key >= UNIO_KV_MAX_KEYS) || (record[1] > UNIO_KV_MAX_VALUE))
+				continue;											//Erased (0xFF) or not a record
+			if (unio_kv_crc8(record, (UNIO_EEPROM_PAGE_SIZE - 1)) != record[UNIO_EEPROM_PAGE_SIZE - 1])
+				continue;											//Corrupt (e.g. power lost during write)
+			sequence = ((uint16_t)record[2] << 8) | record[3];
+
+			//----- KEEP IF NEWEST FOR THIS KEY -----
+			if ((unio_kv_index[key].page == UNIO_KV_NO_PAGE) || ((int16_t)(sequence - unio_kv_index[key].sequence) > 0))
+			{
+				unio_kv_index[key].page = page + index;
+				unio_kv_index[key].length = record[1];
+				unio_kv_index[key].sequence = sequence;
+				memcpy(&unio_kv_index[key].value[0], &record[UNIO_KV_RECORD_HEADER], UNIO_KV_MAX_VALUE);
+			}
+
+			//----- THE NEXT WRITE GOES AFTER THE NEWEST RECORD -----
+			if ((!found) || ((int16_t)(sequence - newest_sequence) > 0))
+			{
+				newest_sequence = sequence;
+				unio_kv_head = page + index + 1;
+				if (unio_kv_head >= UNIO_KV_PAGES)
+					unio_kv_head = 0;
+				found = 1;
+			}
+		}
+	}
+
+	unio_kv_sequence = found ? (newest_sequence + 1) : 0;
+	unio_kv_mounted = 1;
+	return(1);
+}
+
+
+//****************************
+//****************************
+//********** KV GET **********
+//****************************
+//****************************
+//Copies up to length bytes of the current value of key from RAM (no bus access).  data is left unchanged if the key has no value.
+//Returns:
+//	Length of the stored value, 0 if the key has no value
+uint8_t unio_kv_get (uint8_t key, uint8_t *data, uint8_t length)
+{
+	if ((!unio_kv_mounted) || (key >= UNIO_KV_MAX_KEYS) || (unio_kv_index[key].page == UNIO_KV_NO_PAGE))
+		return(0);
+
+	if (length > unio_kv_index[key].length)
+		length = unio_kv_index[key].length;
+	memcpy(data, &unio_kv_index[key].value[0], length);
+
+	return(unio_kv_index[key].length);
+}
+
+
+//****************************
+//****************************
+//********** KV PUT **********
+//****************************
+//****************************
+//Writes a new record for key unless the value is unchanged.  If the record had to skip over pages still holding the current record of
+//other keys, the oldest of them is then moved forward so rarely written keys don't stop their pages being worn evenly.
+//Returns:
+//	1 is sucessful, 0 if failed (the previous value is kept)
+BYTE unio_kv_put (uint8_t key, uint8_t *data, uint8_t length)
+{
+	UNIO_KV_ENTRY previous;
+	uint8_t head;
+	uint8_t owner;
+
+	if ((!unio_kv_mounted) || (key >= UNIO_KV_MAX_KEYS) || (length > UNIO_KV_MAX_VALUE))
+		return(0);
+
+	if ((unio_kv_index[key].page != UNIO_KV_NO_PAGE) && (unio_kv_index[key].length == length) &&
+		(memcmp(&unio_kv_index[key].value[0], data, length) == 0))
+	{
+		return(1);									//No change
+	}
+
+	//----- WRITE THE NEW RECORD -----
+	previous = unio_kv_index[key];
+	unio_kv_index[key].length = length;
+	memset(&unio_kv_index[key].value[0], 0xff, UNIO_KV_MAX_VALUE);
+	memcpy(&unio_kv_index[key].value[0], data, length);
+
+	head = unio_kv_head;
+	if (!unio_kv_write_record(key))
+	{
+		unio_kv_index[key] = previous;
+		return(0);
+	}
+
+	//----- COMPACTION - MOVE A SKIPPED RECORD FORWARD -----
+	for (owner = 0; owner < UNIO_KV_MAX_KEYS; owner++)
+	{
+		if ((owner != key) && (unio_kv_index[owner].page == head))
+		{
+			unio_kv_write_record(owner);			//(If this fails the record is still valid where it was)
+			break;
+		}
+	}
+	return(1);
+}
+
+
+//**********************************
+//**********************************
+//********** WRITE RECORD **********
+//**********************************
+//**********************************
+//Writes the RAM value of key as a new record in the first page from unio_kv_head on that doesn't hold the current record of any key
+//(including key itself, so the previous record survives a failed write).  The index is only updated if the write succeeds.
+//Returns:
+//	1 is sucessful, 0 if failed
+BYTE unio_kv_write_record (uint8_t key)
+{
+	uint8_t page;
+	uint8_t owner;
+	uint8_t pages_checked;
+
+	//----- FIND A FREE PAGE -----
+	page = unio_kv_head;
+	for (pages_checked = 0; pages_checked < UNIO_KV_PAGES; pages_checked++)
+	{
+		for (owner = 0; owner < UNIO_KV_MAX_KEYS; owner++)
+		{
+			if (unio_kv_index[owner].page == page)
+				break;
+		}
+		if (owner >= UNIO_KV_MAX_KEYS)
+			break;
+		if (++page >= UNIO_KV_PAGES)
+			page = 0;
+	}
+	if (pages_checked >= UNIO_KV_PAGES)
+		return(0);									//No free page (UNIO_KV_MAX_KEYS must be less than UNIO_KV_PAGES)
+
+	//----- BUILD THE RECORD -----
+	unio_kv_buffer[0] = key;
+	unio_kv_buffer[1] = unio_kv_index[key].length;
+	unio_kv_buffer[2] = (uint8_t)(unio_kv_sequence >> 8);
+	unio_kv_buffer[3] = (uint8_t)(unio_kv_sequence & 0x00ff);
+	memcpy(&unio_kv_buffer[UNIO_KV_RECORD_HEADER], &unio_kv_index[key].value[0], UNIO_KV_MAX_VALUE);
+	unio_kv_buffer[UNIO_EEPROM_PAGE_SIZE - 1] = unio_kv_crc8(&unio_kv_buffer[0], (UNIO_EEPROM_PAGE_SIZE - 1));
+
+	//----- WRITE IT -----
+	//The page and sequence number are used up even if the write fails, as the page contents are now unknown
+	unio_kv_page_writes++;
+	unio_kv_head = page + 1;
+	if (unio_kv_head >= UNIO_KV_PAGES)
+		unio_kv_head = 0;
+	unio_kv_sequence++;
+
+	if (!unio_eeprom_write(((uint16_t)(UNIO_KV_START_PAGE + page) * UNIO_EEPROM_PAGE_SIZE), &unio_kv_buffer[0], UNIO_EEPROM_PAGE_SIZE))
+		return(0);
+
+	unio_kv_index[key].page = page;
+	unio_kv_index[key].sequence = unio_kv_sequence - 1;
+	return(1);
+}
+
+
+//**************************
+//**************************
+//********** CRC8 **********
+//**************************
+//**************************
+//CRC-8 (polynomial 0x07, initial value UNIO_KV_CRC_INIT)
+uint8_t unio_kv_crc8 (uint8_t *data, uint8_t length)
+{
+	uint8_t crc = UNIO_KV_CRC_INIT;
+	uint8_t bit;
+
+	while (length--)
+	{
+		crc ^= *data++;
+		for (bit = 0; bit < 8; bit++)
+		{
+			if (crc & 0x80)
+				crc = (uint8_t)((crc << 1) ^ 0x07);
+			else
+				crc <<= 1;
+		}
+	}
+	return(crc);
+}
@@ -0,0 +1,173 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name:	11LC010T EEPROM USING UNI/O 1 WIRE BUS - WEAR LEVELLED KEY / VALUE STORE
+
+
+
+//###########################################
+//###########################################
+//##### WEAR LEVELLED KEY / VALUE STORE #####
+//###########################################
+//###########################################
+//Instead of giving each value a fixed address (so a frequently written value wears out its page), every write of a value is appended
+//as a new record in the next page of a circular log:
+//- Each record is one page: key, length, 16 bit sequence number, value (up to UNIO_KV_MAX_VALUE bytes) and a CRC8.
+//- Pages are used in turn, so every page of the store wears at the same rate whatever keys are written.
+//- unio_kv_mount() reads the store sequentially and keeps the newest valid record of each key in RAM, so unio_kv_get() never uses the bus.
+//- Before the oldest page is reused, if it still holds the current record of another key, that record is rewritten there with a new
+//  sequence number (compaction), so values are never lost.  UNIO_KV_MAX_KEYS must be less than UNIO_KV_PAGES.
+//- A record that was being written at power loss fails its CRC and the previous record of that key is used.
+
+
+
+//##############################
+//##############################
+//##### USING IN A PROJECT #####
+//##############################
+//##############################
+/*
+	#define	KV_KEY_BOOT_COUNT		0
+
+	uint32_t boot_count = 0;
+
+	unio_eeprom_init();
+	if (!unio_kv_mount())
+	{
+		//EEPROM NOT PRESENT / READ FAILED
+		Nop();
+	}
+
+	unio_kv_get(KV_KEY_BOOT_COUNT, (uint8_t*)&boot_count, sizeof(boot_count));		//Left unchanged if not found
+	boot_count++;
+	if (!unio_kv_put(KV_KEY_BOOT_COUNT, (uint8_t*)&boot_count, sizeof(boot_count)))
+	{
+		//WRITE FAILED
+		Nop();
+	}
+*/
+
+
+
+//*****************************
+//*****************************
+//********** DEFINES **********
+//*****************************
+//*****************************
+#ifndef MEM_EXT_UNIO_KV_C_INIT		//(Do only once)
+#define	MEM_EXT_UNIO_KV_C_INIT
+
+#include "mem-11lcxxx.h"
+
+#define	UNIO_KV_START_PAGE				0			//First page of the device used by the store
+#define	UNIO_KV_PAGES					8			//Number of pages used by the store (8 = whole of an 11LC010)
+#define	UNIO_KV_MAX_KEYS				4			//Keys 0 to UNIO_KV_MAX_KEYS - 1.  Must be less than UNIO_KV_PAGES (more spare pages = less compaction)
+#define	UNIO_KV_SCAN_PAGES				8			//Pages read in each sequential read by unio_kv_mount() (RAM buffer size, UNIO_KV_PAGES for a single read)
+
+#define	UNIO_KV_RECORD_HEADER			4			//Key, length, sequence H, sequence L
+#define	UNIO_KV_MAX_VALUE				(UNIO_EEPROM_PAGE_SIZE - UNIO_KV_RECORD_HEADER - 1)		//(11 bytes with 16 byte pages)
+#define	UNIO_KV_NO_PAGE					0xff
+#define	UNIO_KV_CRC_INIT				0xff		//Non zero so an all zero page doesn't have a valid CRC (read as key 0, length 0)
+
+typedef struct _UNIO_KV_ENTRY
+{
+	uint8_t page;								//Page within the store holding the current record, UNIO_KV_NO_PAGE if the key has no value
+	uint8_t length;
+	uint16_t sequence;
+	uint8_t value[UNIO_KV_MAX_VALUE];
+} UNIO_KV_ENTRY;
+
+
+#endif
+
+
+//*******************************
+//*******************************
+//********** FUNCTIONS **********
+//*******************************
+//*******************************
+#ifdef MEM_EXT_UNIO_KV_C
+//-----------------------------------
+//----- INTERNAL ONLY FUNCTIONS -----
+//-----------------------------------
+BYTE unio_kv_write_record (uint8_t key);
+uint8_t unio_kv_crc8 (uint8_t *data, uint8_t length);
+
+
+//-----------------------------------------
+//----- INTERNAL & EXTERNAL FUNCTIONS -----
+//-----------------------------------------
+//(Also defined below as extern)
+BYTE unio_kv_mount (void);
+uint8_t unio_kv_get (uint8_t key, uint8_t *data, uint8_t length);
+BYTE unio_kv_put (uint8_t key, uint8_t *data, uint8_t length);
+
+#else
+//------------------------------
+//----- EXTERNAL FUNCTIONS -----
+//------------------------------
+extern BYTE unio_kv_mount (void);
+extern uint8_t unio_kv_get (uint8_t key, uint8_t *data, uint8_t length);
+extern BYTE unio_kv_put (uint8_t key, uint8_t *data, uint8_t length);
+
+#endif
+
+
+
+
+//****************************
+//****************************
+//********** MEMORY **********
+//****************************
+//****************************
+#ifdef MEM_EXT_UNIO_KV_C
+//--------------------------------------------
+//----- INTERNAL ONLY MEMORY DEFINITIONS -----
+//--------------------------------------------
+UNIO_KV_ENTRY unio_kv_index[UNIO_KV_MAX_KEYS];
+uint8_t unio_kv_head;							//Next page to write (the oldest page)
+uint16_t unio_kv_sequence;						//Sequence number for the next record
+uint8_t unio_kv_mounted;
+uint8_t unio_kv_buffer[UNIO_KV_SCAN_PAGES * UNIO_EEPROM_PAGE_SIZE];
+
+
+//--------------------------------------------------
+//----- INTERNAL & EXTERNAL MEMORY DEFINITIONS -----
+//--------------------------------------------------
+//(Also defined below as extern)
+uint16_t unio_kv_page_writes;					//Pages written including compaction (for monitoring)
+
+
+#else
+//---------------------------------------
+//----- EXTERNAL MEMORY DEFINITIONS -----
+//---------------------------------------
+extern uint16_t unio_kv_page_writes;
+
+
+#endif
@@ -0,0 +1,512 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name: 11LC010T EEPROM USING UNI/O 1 WIRE BUS - MULTI BUS ENGINE
+
+
+
+#include "main.h"					//Global data type definitions (see https://github.com/ibexuk/C_Generic_Header_File )
+
+
+#define	MEM_EXT_UNIO_MULTI_C		//(Our header file define)
+
+#include "mem-11lcxxx-multi.h"
+
+
+//******************************************
+//******************************************
+//********** INITIALISE ALL BUSES **********
+//******************************************
+//******************************************
+void unio_multi_init (void)
+{
+	UNIO_MULTI_SCIO_TRIS(0);
+	UNIO_MULTI_SCIO_OUTPUT(0);
+
+	//Setup the timer ready for us to use
+	unio_timer_acquire();
+
+	unio_delay_5us(1);							//Delay to ensure minimum pulse width of 125 ns
+
+	UNIO_MULTI_SCIO_OUTPUT(UNIO_MULTI_ALL_BUSES);	//Bring high to release from POR
+
+	unio_delay_5us(120);						//Hold SCIO high for min 600uS (Tstby) to generate standby pulse.
+	unio_timer_release();
+}
+
+
+//********************************
+//********************************
+//********** MULTI READ **********
+//********************************
+//********************************
+//Reads the same address range from each bus in bus_mask into data[bus] (a buffer per bus) in parallel.  Length is not limited to a page.
+//Returns:
+//	Mask of the buses read sucessfully.  Buses that failed have their data set to 0x00.
+uint8_t unio_multi_read (uint8_t bus_mask, uint16_t address, uint8_t **data, uint16_t length)
+{
+	uint8_t retry_count = 3;
+	uint8_t pending;
+	uint8_t done;
+	uint8_t success = 0;
+	uint8_t bus;
+	uint16_t count;
+
+	if ((length < 1) || (((uint32_t)address + length) > UNIO_EEPROM_SIZE))
+		return(0);
+
+	pending = bus_mask & UNIO_MULTI_ALL_BUSES;
+	while ((pending) && (retry_count--))
+	{
+		done = unio_multi_transaction(pending, 0b00000011, 1, address, 0, 0, data, 0, length);		//READ command
+		success |= done;
+		pending &= ~done;
+		if (pending)
+		{
+			unio_multi_standby_pulse();				//There was a read error, try again
+			if (retry_count)
+				unio_stats.read_retries++;
+		}
+	}
+	if (pending)
+		unio_stats.failures++;
+
+	//----- FAILED BUSES -----
+	for (bus = 0; bus < UNIO_MULTI_BUSES; bus++)
+	{
+		if (pending & (0x01 << bus))
+		{
+			for (count = 0; count < length; count++)
+				data[bus][count] = 0x00;
+		}
+	}
+	return(success);
+}
+
+
+//*********************************
+//*********************************
+//********** MULTI WRITE **********
+//*********************************
+//*********************************
+//Writes data[bus] (a buffer per bus, may all point to the same data) to the same address on each bus in bus_mask in parallel.  The data
+//must be within the same 16 byte page.  WREN, WRITE, WIP polling and the read back verify are each a single transaction for all buses,
+//a bus drops out of WIP polling as soon as its write cycle completes.
+//Returns:
+//	Mask of the buses written and verified sucessfully
+uint8_t unio_multi_write (uint8_t bus_mask, uint16_t address, uint8_t **data, uint8_t length)
+{
+	uint8_t retry_count = 3;
+	uint8_t pending;
+	uint8_t written;
+	uint8_t busy;
+	uint8_t responded;
+	uint8_t success = 0;
+	uint8_t bus;
+	uint8_t status[UNIO_MULTI_BUSES];
+	uint8_t *status_data[UNIO_MULTI_BUSES];
+	uint32_t write_start_ticks;
+	uint32_t max_elapsed;
+
+	if (length < 1)
+		return(0);
+
+	if (length > UNIO_EEPROM_PAGE_SIZE)
+		length = UNIO_EEPROM_PAGE_SIZE;
+
+	if ((((uint32_t)address + length) > UNIO_EEPROM_SIZE) || (((address & (UNIO_EEPROM_PAGE_SIZE - 1)) + length) > UNIO_EEPROM_PAGE_SIZE))
+		return(0);
+
+	for (bus = 0; bus < UNIO_MULTI_BUSES; bus++)
+		status_data[bus] = &status[bus];
+
+	pending = bus_mask & UNIO_MULTI_ALL_BUSES;
+	unio_stats.writes++;
+	while ((pending) && (retry_count--))
+	{
+		if (retry_count < 2)
+			unio_stats.write_retries++;			//(Not the first attempt)
+
+		//----- ENABLE WRITES -----
+		written = unio_multi_transaction(pending, 0b10010110, 0, 0, 0, 0, 0, 0, 0);				//WREN command
+
+		//----- WRITE -----
+		written = unio_multi_transaction(written, 0b01101100, 1, address, data, length, 0, 0, 0);	//WRITE command
+
+		//----- WIP POLLING -----
+		busy = written;
+		write_start_ticks = unio_bus_ticks;
+		max_elapsed = UNIO_EEPROM_US_TO_TICKS(UNIO_EEPROM_WRITE_CYCLE_US * 2);		//Give up after twice the max write cycle time (as unio_wait_for_write_complete())
+		while ((busy) && ((unio_bus_ticks - write_start_ticks) <= max_elapsed))
+		{
+			unio_stats.wip_polls++;
+			responded = unio_multi_transaction(busy, 0b00000101, 0, 0, 0, 0, &status_data[0], 0, 1);	//RDSR command
+			written &= ~(busy & ~responded);
+			busy = 0;
+			for (bus = 0; bus < UNIO_MULTI_BUSES; bus++)
+			{
+				if ((responded & (0x01 << bus)) && (status[bus] & 0x01))
+					busy |= (0x01 << bus);
+			}
+		}
+		if (busy)
+			unio_stats.wip_timeouts++;
+		written &= ~busy;
+
+		//----- READ BACK AND VERIFY -----
+		if (written)
+		{
+			written = unio_multi_transaction(written, 0b00000011, 1, address, 0, 0, 0, data, length);	//READ command
+			if (unio_multi_mismatch)
+				unio_stats.verify_errors++;
+		}
+
+		success |= written;
+		pending &= ~written;
+		if (pending)
+			unio_multi_standby_pulse();				//There was a write error, try again
+	}
+	if (pending)
+		unio_stats.failures++;
+	return(success);
+}
+
+
+
+//***************************************
+//***************************************
+//********** MULTI TRANSACTION **********
+//***************************************
+//***************************************
+//One bus transaction on every bus in bus_mask at the same time:
+//Start header, device address, command, [address H, address L], [tx_length bytes from tx_data[bus]], [rx_length bytes to rx_data[bus]
+//or compared with compare_data[bus]].  NoMAK is sent after the last byte.
+//Returns:
+//	Mask of the buses that completed with every SAK and Manchester bit good (and every compared byte matching)
+uint8_t unio_multi_transaction (uint8_t bus_mask, uint8_t command, uint8_t send_address, uint16_t address, uint8_t **tx_data, uint8_t tx_length,
+								uint8_t **rx_data, uint8_t **compare_data, uint16_t rx_length)
+{
+	uint16_t frames;
+	uint16_t frame;
+	uint16_t count;
+	uint8_t bus;
+	uint8_t bit;
+	uint8_t value;
+
+	unio_multi_active = bus_mask & UNIO_MULTI_ALL_BUSES;
+	unio_multi_mismatch = 0;
+	if (!unio_multi_active)
+		return(0);
+
+	frames = (send_address ? 4 : 2) + tx_length + rx_length;		//(After the start header)
+	frame = 1;
+
+	unio_timer_acquire();
+	DISABLE_INT;
+	unio_stats_int_off_begin();
+	unio_delay_5us(2);							//Observe Tss time (min 10uS, no max)
+
+	//----- HEADER -----
+	UNIO_MULTI_SCIO_OUTPUT(UNIO_MULTI_ALL_BUSES & ~unio_multi_active);		//Hold SCIO low on our buses for Thdr (min 5uS)
+	UNIO_MULTI_SCIO_TRIS(0);
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	unio_bus_ticks += unio_quarters_per_5us;
+	for (bus = unio_quarters_per_5us; bus; bus--)
+	{
+		while (!UNIO_EEPROM_READ_IRQ_FLAG())
+			;
+		UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	}
+
+	unio_multi_slice_byte(0x55);				//Start header
+	unio_multi_output_frame(1, 0);				//(no SAK sent after header as device not addressed yet)
+
+	//----- DEVICE ADDRESS -----
+	unio_multi_slice_byte(UNIO_EEPROM_ADDRESS);
+	unio_multi_output_frame((frame++ < frames), 1);
+
+	//----- COMMAND -----
+	unio_multi_slice_byte(command);
+	unio_multi_output_frame((frame++ < frames), 1);
+
+	if (send_address)
+	{
+		//----- START ADDRESS H -----
+		unio_multi_slice_byte((uint8_t)((address & 0xff00) >> 8));
+		unio_multi_output_frame((frame++ < frames), 1);
+
+		//----- START ADDRESS L -----
+		unio_multi_slice_byte((uint8_t)(address & 0x00ff));
+		unio_multi_output_frame((frame++ < frames), 1);
+	}
+
+	//----- DATA BYTES OUT -----
+	for (count = 0; (count < tx_length) && (unio_multi_active); count++)
+	{
+		unio_multi_slice_buses(tx_data, count);
+		unio_multi_output_frame((frame++ < frames), 1);		//NoMAK on last byte to trigger write
+	}
+
+	//----- DATA BYTES IN -----
+	for (count = 0; (count < rx_length) && (unio_multi_active); count++)
+	{
+		unio_multi_input_frame(frame++ < frames);
+
+		for (bus = 0; bus < UNIO_MULTI_BUSES; bus++)
+		{
+			if (!(unio_multi_active & (0x01 << bus)))
+				continue;
+
+			value = 0;
+			for (bit = 0; bit < 8; bit++)
+				value = (uint8_t)((value << 1) | ((unio_multi_slices[bit] >> bus) & 0x01));
+
+			if (rx_data)
+				rx_data[bus][count] = value;
+			else if (compare_data[bus][count] != value)
+				unio_multi_mismatch |= (0x01 << bus);
+		}
+	}
+
+	unio_multi_idle();
+	unio_stats_int_off_end();
+	ENABLE_INT;
+	unio_timer_release();
+
+	return(unio_multi_active & ~unio_multi_mismatch);
+}
+
+
+//********************************
+//********************************
+//********** SLICE BYTE **********
+//********************************
+//********************************
+//Load the same byte for every bus
+void unio_multi_slice_byte (uint8_t value)
+{
+	uint8_t bit;
+
+	for (bit = 0; bit < 8; bit++)
+	{
+		unio_multi_slices[bit] = (value & 0x80) ? 0xff : 0x00;
+		value <<= 1;
+	}
+}
+
+
+//*********************************
+//*********************************
+//********** SLICE BUSES **********
+//*********************************
+//*********************************
+//Load data[bus][index] for each active bus
+void unio_multi_slice_buses (uint8_t **data, uint16_t index)
+{
+	uint8_t bus;
+	uint8_t bit;
+	uint8_t value;
+
+	for (bit = 0; bit < 8; bit++)
+		unio_multi_slices[bit] = 0;
+
+	for (bus = 0; bus < UNIO_MULTI_BUSES; bus++)
+	{
+		if (!(unio_multi_active & (0x01 << bus)))
+			continue;
+
+		value = data[bus][index];
+		for (bit = 0; bit < 8; bit++)
+		{
+			if (value & 0x80)
+				unio_multi_slices[bit] |= (0x01 << bus);
+			value <<= 1;
+		}
+	}
+}
+
+
+//**********************************
+//**********************************
+//********** OUTPUT FRAME **********
+//**********************************
+//**********************************
+//Output the sliced byte, MAK (or NoMAK) and input SAK.  Buses with no SAK are dropped if check_sak is set.
+void unio_multi_output_frame (uint8_t mak, uint8_t check_sak)
+{
+	uint8_t bit;
+	uint8_t sak;
+
+	UNIO_MULTI_SCIO_TRIS(0);					//Ensure SCIO is outputting
+	for (bit = 0; bit < 8; bit++)
+		unio_multi_output_bit(unio_multi_slices[bit]);
+
+	unio_multi_output_bit(mak ? 0xff : 0x00);
+
+	while (!UNIO_EEPROM_READ_IRQ_FLAG())		//Hold the end of the MAK bit until the SAK bit starts
+		;
+	UNIO_MULTI_SCIO_TRIS(unio_multi_active);	//Set SCIO to be an input on our buses
+	sak = unio_multi_input_bit();
+	if (check_sak)
+		unio_multi_active &= sak;
+}
+
+
+//*********************************
+//*********************************
+//********** INPUT FRAME **********
+//*********************************
+//*********************************
+//Input a byte into the slices, output MAK (or NoMAK) and input SAK.  Buses with a bad bit or no SAK are dropped.
+void unio_multi_input_frame (uint8_t mak)
+{
+	uint8_t bit;
+
+	UNIO_MULTI_SCIO_TRIS(unio_multi_active);	//Set SCIO to be an input on our buses
+	for (bit = 0; bit < 8; bit++)
+	{
+		unio_multi_slices[bit] = unio_multi_input_bit();
+		unio_multi_active &= ~unio_multi_bad_bit;
+	}
+
+	UNIO_MULTI_SCIO_TRIS(0);
+	unio_multi_output_bit(mak ? 0xff : 0x00);
+
+	while (!UNIO_EEPROM_READ_IRQ_FLAG())		//Hold the end of the MAK bit until the SAK bit starts
+		;
+	UNIO_MULTI_SCIO_TRIS(unio_multi_active);
+	unio_multi_active &= unio_multi_input_bit();
+}
+
+
+//********************************
+//********************************
+//********** OUTPUT BIT **********
+//********************************
+//********************************
+//Manchester encode one bit to every active bus, ones = buses sending a 1.  Buses not active are held high.
+void unio_multi_output_bit (uint8_t ones)
+{
+	uint8_t idle_buses = UNIO_MULTI_ALL_BUSES & ~unio_multi_active;
+
+	ones &= unio_multi_active;
+	unio_bus_ticks += 4;
+
+	while (!UNIO_EEPROM_READ_IRQ_FLAG())
+		;
+	UNIO_MULTI_SCIO_OUTPUT((unio_multi_active & ~ones) | idle_buses);		//First half of bit, if 1 set SCIO low
+
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	while (!UNIO_EEPROM_READ_IRQ_FLAG())
+		;
+
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	while (!UNIO_EEPROM_READ_IRQ_FLAG())
+		;
+	UNIO_MULTI_SCIO_OUTPUT(ones | idle_buses);								//Second half of bit, if 1 set SCIO high
+
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	while (!UNIO_EEPROM_READ_IRQ_FLAG())
+		;
+
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+}
+
+
+//*******************************
+//*******************************
+//********** INPUT BIT **********
+//*******************************
+//*******************************
+//Manchester decode one bit from every active bus
+//Returns:
+//	Mask of the buses that read a 1
+//	unio_multi_bad_bit		Mask of the buses that didn't see both states of the bit
+uint8_t unio_multi_input_bit (void)
+{
+	uint8_t first_half;
+	uint8_t second_half;
+
+	unio_bus_ticks += 4;
+
+	while (!UNIO_EEPROM_READ_IRQ_FLAG())
+		;
+	//We are now at start of bit period
+
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	while (!UNIO_EEPROM_READ_IRQ_FLAG())
+		;
+	first_half = (uint8_t)UNIO_MULTI_SCIO_INPUT;			//1/4 into bit period
+
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	while (!UNIO_EEPROM_READ_IRQ_FLAG())
+		;
+
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	while (!UNIO_EEPROM_READ_IRQ_FLAG())
+		;
+	second_half = (uint8_t)UNIO_MULTI_SCIO_INPUT;			//3/4 into bit period
+
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+
+	//1 = low then high, 0 = high then low, we should see both states otherwise there has been an error
+	unio_multi_bad_bit = (uint8_t)(~(first_half ^ second_half) & unio_multi_active);
+	return((uint8_t)(~first_half & second_half & unio_multi_active));
+}
+
+
+//**************************
+//**************************
+//********** IDLE **********
+//**************************
+//**************************
+//Waits until end of current bit period has been reached, ensures all SCIO lines are high for bus idle
+void unio_multi_idle (void)
+{
+	unio_bus_ticks++;
+	while (!UNIO_EEPROM_READ_IRQ_FLAG())
+		;
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+
+	UNIO_MULTI_SCIO_OUTPUT(UNIO_MULTI_ALL_BUSES);		//Ensure SCIO is high for bus idle
+	UNIO_MULTI_SCIO_TRIS(0);							//Ensure SCIO is outputting
+}
+
+
+//*****************************
+//*****************************
+//********** STANDBY **********
+//*****************************
+//*****************************
+void unio_multi_standby_pulse (void)
+{
+	unio_timer_acquire();
+	unio_multi_idle();
+	unio_delay_5us(120);				//Tstby min 600uS, no max
+	unio_timer_release();
+}
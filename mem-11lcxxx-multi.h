@@ -0,0 +1,158 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name:	11LC010T EEPROM USING UNI/O 1 WIRE BUS - MULTI BUS ENGINE
+
+
+
+//############################
+//############################
+//##### MULTI BUS ENGINE #####
+//############################
+//############################
+//UNI/O only allows one 11LCxxx per SCIO line.  This engine drives up to 8 SCIO lines on the same port together from the same timer,
+//so N devices are read or programmed in the time it takes to do one.
+//- Buses are the UNIO_MULTI_BUSES port bits from UNIO_MULTI_SCIO_SHIFT (bus 0 = lowest bit).
+//- Each byte is bit sliced before it is clocked (slice n holds bit 7-n of every bus), so each half bit is one port write for all buses
+//  and each sample point is one port read for all buses.
+//- Buses can send different data.  A bus that misses a SAK or sees a bad Manchester bit is dropped from the rest of the transaction
+//  (its line is left high) while the others carry on, and is retried after a standby pulse.
+//- Results are returned as a bus mask (bit n = bus n).
+//Interrupts are disabled during each transaction as with the single bus functions.  Each call is counted in the driver's UNIO_STATS (once,
+//not per bus) and each transaction in its interrupt disabled histogram.
+
+
+
+//##############################
+//##############################
+//##### USING IN A PROJECT #####
+//##############################
+//##############################
+/*
+	uint8_t image[UNIO_EEPROM_PAGE_SIZE];
+	uint8_t *bus_data[UNIO_MULTI_BUSES];
+	uint8_t bus_image[UNIO_MULTI_BUSES][UNIO_EEPROM_PAGE_SIZE];
+	uint8_t count;
+	uint8_t ok_buses;
+
+	unio_multi_init();
+
+	//----- PROGRAM THE SAME PAGE INTO EVERY DEVICE -----
+	for (count = 0; count < UNIO_MULTI_BUSES; count++)
+		bus_data[count] = &image[0];
+	ok_buses = unio_multi_write(UNIO_MULTI_ALL_BUSES, 0x0000, &bus_data[0], UNIO_EEPROM_PAGE_SIZE);
+	if (ok_buses != UNIO_MULTI_ALL_BUSES)
+	{
+		//One or more devices failed
+		Nop();
+	}
+
+	//----- READ EVERY DEVICE -----
+	for (count = 0; count < UNIO_MULTI_BUSES; count++)
+		bus_data[count] = &bus_image[count][0];
+	ok_buses = unio_multi_read(UNIO_MULTI_ALL_BUSES, 0x0000, &bus_data[0], UNIO_EEPROM_PAGE_SIZE);
+*/
+
+
+
+//*****************************
+//*****************************
+//********** DEFINES **********
+//*****************************
+//*****************************
+#ifndef MEM_EXT_UNIO_MULTI_C_INIT		//(Do only once)
+#define	MEM_EXT_UNIO_MULTI_C_INIT
+
+#include "mem-11lcxxx.h"
+
+#define	UNIO_MULTI_BUSES					8			//1 to 8
+#define	UNIO_MULTI_ALL_BUSES				((uint8_t)((1 << UNIO_MULTI_BUSES) - 1))
+#define	UNIO_MULTI_SCIO_MASK				((uint16_t)UNIO_MULTI_ALL_BUSES << UNIO_MULTI_SCIO_SHIFT)		//Port bits used (for the HAL macros)
+
+
+#endif
+
+
+//*******************************
+//*******************************
+//********** FUNCTIONS **********
+//*******************************
+//*******************************
+#ifdef MEM_EXT_UNIO_MULTI_C
+//-----------------------------------
+//----- INTERNAL ONLY FUNCTIONS -----
+//-----------------------------------
+uint8_t unio_multi_transaction (uint8_t bus_mask, uint8_t command, uint8_t send_address, uint16_t address, uint8_t **tx_data, uint8_t tx_length,
+								uint8_t **rx_data, uint8_t **compare_data, uint16_t rx_length);
+void unio_multi_slice_byte (uint8_t value);
+void unio_multi_slice_buses (uint8_t **data, uint16_t index);
+void unio_multi_output_frame (uint8_t mak, uint8_t check_sak);
+void unio_multi_input_frame (uint8_t mak);
+void unio_multi_output_bit (uint8_t ones);
+uint8_t unio_multi_input_bit (void);
+void unio_multi_idle (void);
+void unio_multi_standby_pulse (void);
+
+
+//-----------------------------------------
+//----- INTERNAL & EXTERNAL FUNCTIONS -----
+//-----------------------------------------
+//(Also defined below as extern)
+void unio_multi_init (void);
+uint8_t unio_multi_read (uint8_t bus_mask, uint16_t address, uint8_t **data, uint16_t length);
+uint8_t unio_multi_write (uint8_t bus_mask, uint16_t address, uint8_t **data, uint8_t length);
+
+#else
+//------------------------------
+//----- EXTERNAL FUNCTIONS -----
+//------------------------------
+extern void unio_multi_init (void);
+extern uint8_t unio_multi_read (uint8_t bus_mask, uint16_t address, uint8_t **data, uint16_t length);
+extern uint8_t unio_multi_write (uint8_t bus_mask, uint16_t address, uint8_t **data, uint8_t length);
+
+#endif
+
+
+
+
+//****************************
+//****************************
+//********** MEMORY **********
+//****************************
+//****************************
+#ifdef MEM_EXT_UNIO_MULTI_C
+//--------------------------------------------
+//----- INTERNAL ONLY MEMORY DEFINITIONS -----
+//--------------------------------------------
+uint8_t unio_multi_active;						//Buses still in the current transaction
+uint8_t unio_multi_mismatch;					//Buses that read a byte different to compare_data
+uint8_t unio_multi_bad_bit;
+uint8_t unio_multi_slices[8];					//Bit sliced byte, [0] = bit 7 of each bus
+
+
+#endif
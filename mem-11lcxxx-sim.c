@@ -0,0 +1,829 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name: 11LC010T EEPROM USING UNI/O 1 WIRE BUS - HOST SIMULATOR
+
+
+
+#include "main.h"					//Global data type definitions (see https://github.com/ibexuk/C_Generic_Header_File )
+#include <string.h>
+
+
+#define	MEM_EXT_UNIO_SIM_C			//(Our header file define)
+
+#include "mem-11lcxxx-sim.h"
+
+
+//***************************
+//***************************
+//********** RESET **********
+//***************************
+//***************************
+//Powers on the virtual device.  The array is erased to 0xFF, virtual time restarts at 0 and the stats are cleared.
+//Set unio_sim_dev->size / write_cycle_ns / clock_skew_ppm / min_quarter_ns / glitch_byte after calling this if the defaults are not wanted.
+void unio_sim_reset (void)
+{
+	uint8_t index;
+
+	for (index = 0; index < UNIO_SIM_MAX_DEVICES; index++)
+	{
+		unio_sim_dev = &unio_sim_devices[index];
+		memset(unio_sim_dev, 0, sizeof(UNIO_SIM_DEVICE));
+		memset(&unio_sim_dev->memory[0], 0xff, sizeof(unio_sim_dev->memory));
+
+		unio_sim_dev->size = UNIO_SIM_DEFAULT_SIZE;
+		unio_sim_dev->write_cycle_ns = UNIO_SIM_DEFAULT_WRITE_CYCLE_NS;
+		unio_sim_dev->state = UNIO_SIM_STANDBY_WAIT;		//POR - standby pulse needed before first access
+		unio_sim_dev->last_level = 1;
+	}
+	unio_sim_device_count = 1;
+
+	unio_sim_time = 0;
+	unio_sim_next_tick = 0;
+	unio_sim_quarter_ns = 0;
+	unio_sim_timer_period = 0;
+	unio_sim_irq_flag = 0;
+	unio_sim_timer_isr = 0;
+	unio_sim_master_input = 0xffff;
+	unio_sim_master_level = 0xffff;
+	unio_sim_period_start = 0;
+	unio_sim_previous_period_start = 0;
+	unio_sim_capture_time = 0;
+	unio_sim_capture_level = 1;
+	unio_sim_int_disabled = 0;
+	unio_sim_disable_int_hook = 0;
+
+	unio_sim_reset_stats();
+}
+
+
+//*********************************
+//*********************************
+//********** RESET STATS **********
+//*********************************
+//*********************************
+void unio_sim_reset_stats (void)
+{
+	memset(&unio_sim_stats, 0, sizeof(unio_sim_stats));
+}
+
+
+
+//***********************************
+//***********************************
+//********** VIRTUAL TIMER **********
+//***********************************
+//***********************************
+//Replacement for the hardware timer.  period is in timer counts of UNIO_SIM_TIMER_COUNT_NS.
+void unio_sim_open_timer (uint16_t period)
+{
+	unio_sim_timer_period = period;
+	unio_sim_quarter_ns = (uint32_t)period * UNIO_SIM_TIMER_COUNT_NS;
+	unio_sim_next_tick = unio_sim_time + unio_sim_quarter_ns;
+	unio_sim_irq_flag = 0;
+	unio_sim_period_start = unio_sim_time;
+}
+
+void unio_sim_write_timer (uint16_t value)
+{
+	if (value > unio_sim_timer_period)
+		value = unio_sim_timer_period;
+	unio_sim_next_tick = unio_sim_time + ((uint64_t)(unio_sim_timer_period - value) * UNIO_SIM_TIMER_COUNT_NS);
+	unio_sim_period_start = unio_sim_time - ((uint64_t)value * UNIO_SIM_TIMER_COUNT_NS);
+}
+
+void unio_sim_clear_irq_flag (void)
+{
+	unio_sim_irq_flag = 0;
+}
+
+//The driver only ever reads the flag to wait for it, so if it is not set we jump straight to the next roll over
+uint8_t unio_sim_read_irq_flag (void)
+{
+	if (unio_sim_quarter_ns == 0)
+		return(1);						//Timer not setup
+
+	if (!unio_sim_irq_flag)
+		unio_sim_advance_to(unio_sim_next_tick);
+
+	return(unio_sim_irq_flag);
+}
+
+
+//Timer interrupt - the isr is called at each roll over (after the device has seen the quarter bit period that just ended)
+void unio_sim_enable_timer_irq (void (*isr)(void))
+{
+	unio_sim_timer_isr = isr;
+}
+
+//Let time pass while the driver waits for the timer interrupt to do something
+void unio_sim_idle_wait (void)
+{
+	if (unio_sim_quarter_ns)
+		unio_sim_advance_to(unio_sim_next_tick);
+}
+
+
+//***************************************
+//***************************************
+//********** INTERRUPT DISABLE **********
+//***************************************
+//***************************************
+//Optional replacements for DISABLE_INT / ENABLE_INT in the host main.h so the time the driver holds interrupts off is measured.
+//Repeated calls are allowed, an ENABLE_INT without a DISABLE_INT is counted in unio_sim_stats.int_unmatched_enables.
+void unio_sim_disable_int (void)
+{
+	if (unio_sim_disable_int_hook)
+		unio_sim_disable_int_hook();			//(Test hook, e.g. to change the device contents part way through a driver call)
+
+	if (unio_sim_int_disabled)
+		return;
+
+	unio_sim_int_disabled = 1;
+	unio_sim_int_disabled_time = unio_sim_time;
+}
+
+void unio_sim_enable_int (void)
+{
+	uint64_t disabled_ns;
+
+	if (!unio_sim_int_disabled)
+	{
+		unio_sim_stats.int_unmatched_enables++;
+		return;
+	}
+
+	unio_sim_int_disabled = 0;
+	disabled_ns = unio_sim_time - unio_sim_int_disabled_time;
+	unio_sim_stats.int_disabled_ns += disabled_ns;
+	if (disabled_ns > unio_sim_stats.int_disabled_max_ns)
+		unio_sim_stats.int_disabled_max_ns = disabled_ns;
+}
+
+
+
+//**********************************
+//**********************************
+//********** ADVANCE TIME **********
+//**********************************
+//**********************************
+void unio_sim_advance_to (uint64_t time)
+{
+	while ((unio_sim_quarter_ns) && (unio_sim_next_tick <= time))
+	{
+		unio_sim_time = unio_sim_next_tick;
+		unio_sim_next_tick += unio_sim_quarter_ns;
+		unio_sim_irq_flag = 1;
+		unio_sim_previous_period_start = unio_sim_period_start;
+		unio_sim_period_start = unio_sim_time;
+
+		unio_sim_quarter_tick();
+
+		if (unio_sim_timer_isr)
+			unio_sim_timer_isr();					//Timer interrupt enabled
+	}
+	if (time > unio_sim_time)
+		unio_sim_time = time;
+}
+
+
+
+//******************************
+//******************************
+//********** SCIO PIN **********
+//******************************
+//******************************
+void unio_sim_scio_tris (uint8_t input)
+{
+	if (input)
+		unio_sim_master_input |= 0x0001;
+	else
+		unio_sim_master_input &= ~0x0001;
+}
+
+void unio_sim_scio_output (uint8_t level)
+{
+	if (level)
+		unio_sim_master_level |= 0x0001;
+	else
+		unio_sim_master_level &= ~0x0001;
+}
+
+//The line is pulled high when neither end is driving it
+uint8_t unio_sim_scio_input (void)
+{
+	return((uint8_t)(unio_sim_port_input() & 0x0001));
+}
+
+
+
+//************************************************
+//************************************************
+//********** SCIO INPUT CAPTURE (BUS 0) **********
+//************************************************
+//************************************************
+//Returns the timer count at the oldest SCIO edge not yet returned in the timer period that has just ended, or UNIO_SIM_NO_CAPTURE.
+//Edges are found by stepping through the period one timer count at a time, so the resolution is the same as a hardware capture.
+uint16_t unio_sim_capture_read (void)
+{
+	uint64_t time;
+	uint8_t level;
+
+	if (unio_sim_capture_time < unio_sim_previous_period_start)
+	{
+		//Edges from earlier periods have been lost (not read in time)
+		unio_sim_capture_time = unio_sim_previous_period_start;
+		unio_sim_capture_level = unio_sim_scio_level(unio_sim_capture_time);
+	}
+
+	for (time = unio_sim_capture_time + UNIO_SIM_TIMER_COUNT_NS; time <= unio_sim_period_start; time += UNIO_SIM_TIMER_COUNT_NS)
+	{
+		level = unio_sim_scio_level(time);
+		if (level != unio_sim_capture_level)
+		{
+			unio_sim_capture_level = level;
+			unio_sim_capture_time = time;
+			return((uint16_t)((time - unio_sim_previous_period_start) / UNIO_SIM_TIMER_COUNT_NS));
+		}
+	}
+	if (unio_sim_period_start > unio_sim_capture_time)
+		unio_sim_capture_time = unio_sim_period_start;
+	return(UNIO_SIM_NO_CAPTURE);
+}
+
+//Level of the bus 0 SCIO line at a time in the current or previous timer period (the master drive is assumed not to have changed)
+uint8_t unio_sim_scio_level (uint64_t time)
+{
+	if (!((unio_sim_master_input | unio_sim_master_level) & 0x0001))
+		return(0);
+	return(unio_sim_device_level(&unio_sim_devices[0], time));
+}
+
+
+
+//*******************************************
+//*******************************************
+//********** SCIO PORT (MULTI BUS) **********
+//*******************************************
+//*******************************************
+//One SCIO line per port bit, bit n is the bus of unio_sim_devices[n]
+void unio_sim_port_tris (uint16_t input_mask)
+{
+	unio_sim_master_input = input_mask;
+}
+
+void unio_sim_port_output (uint16_t levels)
+{
+	unio_sim_master_level = levels;
+}
+
+uint16_t unio_sim_port_input (void)
+{
+	uint8_t index;
+	uint16_t levels;
+
+	levels = unio_sim_master_input | unio_sim_master_level;
+	for (index = 0; index < unio_sim_device_count; index++)
+	{
+		if (!unio_sim_device_level(&unio_sim_devices[index], unio_sim_time))
+			levels &= ~(0x0001 << index);
+	}
+	return(levels);
+}
+
+
+
+//*****************************************
+//*****************************************
+//********** DEVICE OUTPUT LEVEL **********
+//*****************************************
+//*****************************************
+//The device clocks its own output bits from its own (possibly skewed) clock, starting from the master bit edge it responded to
+uint8_t unio_sim_device_level (UNIO_SIM_DEVICE *device, uint64_t time)
+{
+	uint64_t elapsed;
+	uint64_t bit_ns;
+	uint64_t bit_number;
+	uint8_t bit;
+	uint8_t second_half;
+
+	if ((device->drive_count == 0) || (time < device->drive_start))
+		return(1);
+
+	elapsed = time - device->drive_start;
+	bit_ns = (uint64_t)device->drive_quarter_ns << 2;
+	bit_number = elapsed / bit_ns;
+	if (bit_number >= device->drive_count)
+		return(1);								//Released
+
+	bit = (uint8_t)((device->drive_bits >> (device->drive_count - 1 - bit_number)) & 0x01);
+	second_half = ((elapsed % bit_ns) >= ((uint64_t)device->drive_quarter_ns << 1)) ? 1 : 0;
+
+	if ((device->drive_glitch) && (bit_number == (uint64_t)(device->drive_count - 1)))
+		return(1);								//Glitched bit (no mid bit edge)
+
+	if (bit)
+		return(second_half);					//1 = low then high
+	else
+		return(second_half ? 0 : 1);			//0 = high then low
+}
+
+
+
+//*****************************************
+//*****************************************
+//********** DEVICE QUARTER TICK **********
+//*****************************************
+//*****************************************
+//Called at each timer roll over, clocks each simulated device with the level the master held its SCIO line at during the quarter bit
+//period that has just ended
+void unio_sim_quarter_tick (void)
+{
+	uint8_t index;
+	uint8_t bus_active = 0;
+
+	unio_sim_stats.quarter_periods++;
+	unio_sim_stats.elapsed_ns += unio_sim_quarter_ns;
+
+	for (index = 0; index < unio_sim_device_count; index++)
+	{
+		unio_sim_dev = &unio_sim_devices[index];
+
+		unio_sim_update_write_cycle();
+
+		if ((unio_sim_dev->state == UNIO_SIM_HEADER_LOW) || (unio_sim_dev->state == UNIO_SIM_ACTIVE))
+			bus_active = 1;
+
+		unio_sim_device_quarter_tick(((unio_sim_master_input | unio_sim_master_level) >> index) & 0x0001);
+	}
+
+	if (bus_active)
+		unio_sim_stats.bus_active_ns += unio_sim_quarter_ns;
+}
+
+
+//Clock the device unio_sim_dev
+void unio_sim_device_quarter_tick (uint8_t level)
+{
+	uint8_t edge = 0;
+	uint64_t quarter_start;
+	uint64_t previous_duration = 0;
+	uint8_t second_half;
+	uint8_t bit;
+
+
+	quarter_start = unio_sim_time - unio_sim_quarter_ns;
+	if (level != unio_sim_dev->last_level)
+	{
+		edge = 1;
+		previous_duration = (quarter_start > unio_sim_dev->level_since) ? (quarter_start - unio_sim_dev->level_since) : 0;
+		unio_sim_dev->level_since = quarter_start;
+		unio_sim_dev->last_level = level;
+	}
+
+	switch (unio_sim_dev->state)
+	{
+	case UNIO_SIM_STANDBY_WAIT:
+		if ((level) && ((unio_sim_time - unio_sim_dev->level_since) >= UNIO_SIM_TSTBY_NS))
+			unio_sim_dev->state = UNIO_SIM_IDLE;
+		break;
+
+	case UNIO_SIM_IDLE:
+		if ((edge) && (!level) && (previous_duration >= UNIO_SIM_TSS_NS))
+			unio_sim_dev->state = UNIO_SIM_HEADER_LOW;
+		break;
+
+	case UNIO_SIM_HEADER_LOW:
+		if ((edge) && (level))
+		{
+			if (previous_duration < UNIO_SIM_THDR_NS)
+			{
+				unio_sim_error();
+				break;
+			}
+			if (unio_sim_quarter_ns < unio_sim_dev->min_quarter_ns)
+			{
+				unio_sim_error();			//Too fast for this bus
+				break;
+			}
+			//First bit of the start header has started - this quarter was quarter 0 of it
+			unio_sim_dev->state = UNIO_SIM_ACTIVE;
+			unio_sim_dev->phase = 0;
+			unio_sim_dev->bit_index = 0;
+			unio_sim_dev->frame_index = 0;
+			unio_sim_dev->device_driving_bits = 0;
+			unio_sim_dev->end_of_transaction = 0;
+			unio_sim_stats.transactions++;
+		}
+		break;
+
+	case UNIO_SIM_ACTIVE:
+		unio_sim_dev->phase = (unio_sim_dev->phase + 1) & 0x03;
+
+		if (unio_sim_dev->device_driving_bits)
+		{
+			//----- BIT NOT DRIVEN BY THE MASTER -----
+			if (unio_sim_dev->phase != 3)
+				break;
+
+			unio_sim_dev->device_driving_bits--;
+			if (++unio_sim_dev->bit_index >= 10)
+			{
+				unio_sim_dev->bit_index = 0;
+				unio_sim_dev->frame_index++;
+			}
+			if ((unio_sim_dev->device_driving_bits == 0) && (unio_sim_dev->end_of_transaction))
+			{
+				unio_sim_dev->state = UNIO_SIM_IDLE;
+				unio_sim_dev->drive_count = 0;
+			}
+			break;
+		}
+
+		//----- BIT DRIVEN BY THE MASTER -----
+		if (unio_sim_dev->phase == 1)
+		{
+			unio_sim_dev->first_half = level;
+		}
+		else if (unio_sim_dev->phase == 3)
+		{
+			second_half = level;
+			if ((unio_sim_dev->first_half) && (!second_half))
+				bit = 0;
+			else if ((!unio_sim_dev->first_half) && (second_half))
+				bit = 1;
+			else
+			{
+				unio_sim_error();			//No mid bit edge
+				break;
+			}
+			unio_sim_bit_complete(bit);
+		}
+		break;
+	}
+}
+
+
+
+//**********************************
+//**********************************
+//********** BIT COMPLETE **********
+//**********************************
+//**********************************
+//A master driven bit has been decoded
+void unio_sim_bit_complete (uint8_t bit)
+{
+	if (unio_sim_dev->bit_index < 8)
+		unio_sim_dev->shift_in = (uint8_t)((unio_sim_dev->shift_in << 1) | bit);
+	else if (unio_sim_dev->bit_index == 8)
+		unio_sim_frame_complete(bit);
+
+	if (unio_sim_dev->state != UNIO_SIM_ACTIVE)
+		return;
+
+	if (++unio_sim_dev->bit_index >= 10)
+	{
+		unio_sim_dev->bit_index = 0;
+		unio_sim_dev->frame_index++;
+	}
+}
+
+
+
+//************************************
+//************************************
+//********** FRAME COMPLETE **********
+//************************************
+//************************************
+//Called at the end of the MAK bit of each frame, we are now at the start of the SAK bit
+void unio_sim_frame_complete (uint8_t mak)
+{
+	uint8_t data = unio_sim_dev->shift_in;
+
+	if (unio_sim_dev->frame_index == 0)
+	{
+		//----- START HEADER -----
+		if ((data != 0x55) || (!mak))
+		{
+			unio_sim_error();
+			return;
+		}
+		unio_sim_dev->device_driving_bits = 1;			//No SAK after the start header
+		return;
+	}
+
+	if (unio_sim_dev->frame_index == 1)
+	{
+		//----- DEVICE ADDRESS -----
+		if (data != 0xa0)
+		{
+			unio_sim_error();
+			return;
+		}
+		if (!mak)
+			unio_sim_dev->end_of_transaction = 1;
+		unio_sim_drive(0, 0);
+		return;
+	}
+
+	if (unio_sim_dev->frame_index == 2)
+	{
+		//----- COMMAND -----
+		unio_sim_dev->command = data;
+		if ((unio_sim_dev->status & UNIO_SIM_STATUS_WIP) && (data != UNIO_SIM_CMD_RDSR))
+		{
+			unio_sim_error();							//Only RDSR is allowed during a write cycle
+			return;
+		}
+
+		switch (data)
+		{
+		case UNIO_SIM_CMD_READ:
+		case UNIO_SIM_CMD_WRITE:
+			if (!mak)
+				unio_sim_dev->end_of_transaction = 1;
+			unio_sim_drive(0, 0);
+			return;
+
+		case UNIO_SIM_CMD_WREN:
+		case UNIO_SIM_CMD_WRDI:
+			if (mak)
+			{
+				unio_sim_error();
+				return;
+			}
+			if (data == UNIO_SIM_CMD_WREN)
+				unio_sim_dev->status |= UNIO_SIM_STATUS_WEL;
+			else
+				unio_sim_dev->status &= ~UNIO_SIM_STATUS_WEL;
+			unio_sim_dev->end_of_transaction = 1;
+			unio_sim_drive(0, 0);
+			return;
+
+		case UNIO_SIM_CMD_ERAL:
+		case UNIO_SIM_CMD_SETAL:
+			if (mak)
+			{
+				unio_sim_error();
+				return;
+			}
+			unio_sim_dev->end_of_transaction = 1;
+			unio_sim_drive(0, 0);
+			if ((unio_sim_dev->status & UNIO_SIM_STATUS_WEL) && ((unio_sim_dev->status & UNIO_SIM_STATUS_BP) == 0))
+				unio_sim_start_write_cycle();			//(Ignored if any block is protected)
+			else
+				unio_sim_dev->status &= ~UNIO_SIM_STATUS_WEL;
+			return;
+
+		case UNIO_SIM_CMD_WRSR:
+			if (!mak)
+			{
+				unio_sim_error();						//Status byte must follow
+				return;
+			}
+			unio_sim_drive(0, 0);
+			return;
+
+		case UNIO_SIM_CMD_RDSR:
+			if (!mak)
+			{
+				unio_sim_dev->end_of_transaction = 1;
+				unio_sim_drive(0, 0);
+				return;
+			}
+			unio_sim_drive(1, unio_sim_dev->status);
+			return;
+
+		default:
+			unio_sim_error();
+			return;
+		}
+	}
+
+	switch (unio_sim_dev->command)
+	{
+	case UNIO_SIM_CMD_RDSR:
+		//----- STATUS REGISTER STREAM -----
+		if (!mak)
+		{
+			unio_sim_dev->end_of_transaction = 1;
+			unio_sim_drive(0, 0);
+			return;
+		}
+		unio_sim_drive(1, unio_sim_dev->status);
+		return;
+
+	case UNIO_SIM_CMD_READ:
+		if (unio_sim_dev->frame_index == 3)
+		{
+			unio_sim_dev->address = (uint16_t)data << 8;
+		}
+		else if (unio_sim_dev->frame_index == 4)
+		{
+			unio_sim_dev->address |= data;
+			unio_sim_dev->address &= (unio_sim_dev->size - 1);		//Upper address bits are don't care
+		}
+
+		if (!mak)
+		{
+			unio_sim_dev->end_of_transaction = 1;
+			unio_sim_drive(0, 0);
+			return;
+		}
+		if (unio_sim_dev->frame_index < 4)
+		{
+			unio_sim_drive(0, 0);
+			return;
+		}
+		//Sequential read - address rolls over at the end of the array
+		unio_sim_drive(1, unio_sim_dev->memory[unio_sim_dev->address]);
+		unio_sim_dev->address = (unio_sim_dev->address + 1) & (unio_sim_dev->size - 1);
+		return;
+
+	case UNIO_SIM_CMD_WRSR:
+		//----- NEW STATUS REGISTER VALUE -----
+		if (mak)
+		{
+			unio_sim_error();
+			return;
+		}
+		unio_sim_dev->end_of_transaction = 1;
+		unio_sim_drive(0, 0);
+		unio_sim_dev->new_status = data & UNIO_SIM_STATUS_BP;
+		if (unio_sim_dev->status & UNIO_SIM_STATUS_WEL)
+			unio_sim_start_write_cycle();
+		return;
+
+	case UNIO_SIM_CMD_WRITE:
+		if (unio_sim_dev->frame_index == 3)
+		{
+			unio_sim_dev->address = (uint16_t)data << 8;
+		}
+		else if (unio_sim_dev->frame_index == 4)
+		{
+			unio_sim_dev->address |= data;
+			unio_sim_dev->address &= (unio_sim_dev->size - 1);
+			unio_sim_dev->page_address = unio_sim_dev->address & ~(UNIO_SIM_PAGE_SIZE - 1);
+			memset(&unio_sim_dev->page_buffer_loaded[0], 0, sizeof(unio_sim_dev->page_buffer_loaded));
+		}
+		else
+		{
+			//Data byte - address rolls over within the page
+			unio_sim_dev->page_buffer[unio_sim_dev->address & (UNIO_SIM_PAGE_SIZE - 1)] = data;
+			unio_sim_dev->page_buffer_loaded[unio_sim_dev->address & (UNIO_SIM_PAGE_SIZE - 1)] = 1;
+			unio_sim_dev->address = unio_sim_dev->page_address | ((unio_sim_dev->address + 1) & (UNIO_SIM_PAGE_SIZE - 1));
+			unio_sim_stats.bytes_written++;
+		}
+
+		if (mak)
+		{
+			unio_sim_drive(0, 0);
+			return;
+		}
+
+		//NoMAK - start the write cycle if we got data, writes are enabled and the page isn't protected
+		unio_sim_dev->end_of_transaction = 1;
+		unio_sim_drive(0, 0);
+		if ((unio_sim_dev->frame_index >= 5) && (unio_sim_dev->status & UNIO_SIM_STATUS_WEL) && (!unio_sim_is_protected(unio_sim_dev->page_address)))
+			unio_sim_start_write_cycle();
+		else
+			unio_sim_dev->status &= ~UNIO_SIM_STATUS_WEL;
+		return;
+	}
+}
+
+
+void unio_sim_start_write_cycle (void)
+{
+	unio_sim_dev->write_command = unio_sim_dev->command;
+	unio_sim_dev->status |= UNIO_SIM_STATUS_WIP;
+	unio_sim_dev->write_complete_time = unio_sim_time + ((uint64_t)unio_sim_quarter_ns << 2) + unio_sim_dev->write_cycle_ns;
+	unio_sim_stats.write_cycles++;
+	unio_sim_stats.write_cycle_ns += unio_sim_dev->write_cycle_ns;
+}
+
+
+//Returns 1 if address is in a block protected by the status register BP bits
+uint8_t unio_sim_is_protected (uint16_t address)
+{
+	switch (unio_sim_dev->status & UNIO_SIM_STATUS_BP)
+	{
+	case 0x04:
+		return((address >= (unio_sim_dev->size - (unio_sim_dev->size >> 2))) ? 1 : 0);		//Upper 1/4
+	case 0x08:
+		return((address >= (unio_sim_dev->size >> 1)) ? 1 : 0);		//Upper 1/2
+	case 0x0c:
+		return(1);
+	default:
+		return(0);
+	}
+}
+
+
+
+//****************************************
+//****************************************
+//********** DRIVE SAK (& BYTE) **********
+//****************************************
+//****************************************
+//Output SAK and optionally a following data byte
+void unio_sim_drive (uint8_t output_byte, uint8_t data)
+{
+	unio_sim_dev->drive_start = unio_sim_time;
+	unio_sim_dev->drive_quarter_ns = (uint32_t)(((int64_t)unio_sim_quarter_ns * (1000000 + unio_sim_dev->clock_skew_ppm)) / 1000000);
+
+	if (output_byte)
+	{
+		unio_sim_dev->drive_bits = 0x0100 | data;			//SAK (1) then the byte MSB first
+		unio_sim_dev->drive_count = 9;
+		unio_sim_stats.bytes_read++;
+		unio_sim_dev->drive_glitch = (unio_sim_stats.bytes_read == unio_sim_dev->glitch_byte) ? 1 : 0;
+	}
+	else
+	{
+		unio_sim_dev->drive_bits = 0x0001;
+		unio_sim_dev->drive_count = 1;
+		unio_sim_dev->drive_glitch = 0;
+	}
+	unio_sim_dev->device_driving_bits = unio_sim_dev->drive_count;
+}
+
+
+
+//***************************
+//***************************
+//********** ERROR **********
+//***************************
+//***************************
+//Stop responding, a standby pulse is needed before the device will accept another start header
+void unio_sim_error (void)
+{
+	unio_sim_dev->state = UNIO_SIM_STANDBY_WAIT;
+	unio_sim_dev->drive_count = 0;
+	unio_sim_dev->device_driving_bits = 0;
+	unio_sim_dev->level_since = unio_sim_time;
+	unio_sim_stats.bus_errors++;
+}
+
+
+
+//****************************************
+//****************************************
+//********** WRITE CYCLE TIMING **********
+//****************************************
+//****************************************
+void unio_sim_update_write_cycle (void)
+{
+	uint8_t count;
+
+	if (!(unio_sim_dev->status & UNIO_SIM_STATUS_WIP))
+		return;
+	if (unio_sim_time < unio_sim_dev->write_complete_time)
+		return;
+
+	switch (unio_sim_dev->write_command)
+	{
+	case UNIO_SIM_CMD_ERAL:
+		memset(&unio_sim_dev->memory[0], 0x00, unio_sim_dev->size);
+		break;
+	case UNIO_SIM_CMD_SETAL:
+		memset(&unio_sim_dev->memory[0], 0xff, unio_sim_dev->size);
+		break;
+	case UNIO_SIM_CMD_WRSR:
+		unio_sim_dev->status = (unio_sim_dev->status & ~UNIO_SIM_STATUS_BP) | unio_sim_dev->new_status;
+		break;
+	default:
+		for (count = 0; count < UNIO_SIM_PAGE_SIZE; count++)
+		{
+			if (unio_sim_dev->page_buffer_loaded[count])
+				unio_sim_dev->memory[unio_sim_dev->page_address + count] = unio_sim_dev->page_buffer[count];
+		}
+		break;
+	}
+	unio_sim_dev->status &= ~(UNIO_SIM_STATUS_WIP | UNIO_SIM_STATUS_WEL);
+}
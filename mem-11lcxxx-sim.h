@@ -0,0 +1,307 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name:	11LC010T EEPROM USING UNI/O 1 WIRE BUS - HOST SIMULATOR
+
+
+
+//#####################################
+//#####################################
+//##### HOST UNI/O BUS SIMULATOR #####
+//#####################################
+//#####################################
+//Allows the driver to be run on a PC (e.g. for benchmarking and regression testing) without a board.
+//- The driver's timer IRQ flag is replaced by a virtual timer.  Each time the driver waits for the flag, virtual time is advanced to the
+//  next timer roll over (one quarter bit period) and the simulated 11LCxxx is clocked.
+//- The simulated device decodes the Manchester bit stream, answers SAK, outputs data and implements READ, WRITE, WREN, WRDI, RDSR,
+//  WRSR (block protection), ERAL and SETAL with a write cycle time during which only RDSR is accepted.
+//- Bus timing requirements (Tstby, Tss, Thdr) are checked, so a driver timing fault shows up as a missing SAK just as it would on a board.
+//- All times are virtual nanoseconds, use unio_sim_stats to measure bus time per operation.
+
+
+
+//##############################
+//##############################
+//##### USING IN A PROJECT #####
+//##############################
+//##############################
+/*
+	Define UNIO_HAL_HOST_SIM for the project (e.g. -DUNIO_HAL_HOST_SIM) and compile mem-11lcxxx.c and mem-11lcxxx-sim.c together.
+	The project main.h needs to provide BYTE, DISABLE_INT and ENABLE_INT as usual (DISABLE_INT / ENABLE_INT may be empty on the host).
+	To measure interrupt disabled time use:
+		#define	DISABLE_INT		unio_sim_disable_int()
+		#define	ENABLE_INT		unio_sim_enable_int()
+
+	uint64_t start_time;
+	uint8_t data[UNIO_EEPROM_PAGE_SIZE];
+
+	unio_sim_reset();						//Power on the virtual device (erased to 0xFF)
+	unio_eeprom_init();
+
+	start_time = unio_sim_stats.elapsed_ns;
+	unio_eeprom_read(0x0000, &data[0], UNIO_EEPROM_PAGE_SIZE);
+	printf("%lu ns per byte\n", (unsigned long)((unio_sim_stats.elapsed_ns - start_time) / UNIO_EEPROM_PAGE_SIZE));
+
+	//Multi bus engine (mem-11lcxxx-multi.c) - one simulated device per port bit
+	unio_sim_reset();
+	unio_sim_device_count = UNIO_MULTI_BUSES;
+	unio_multi_init();
+*/
+
+
+
+//*****************************
+//*****************************
+//********** DEFINES **********
+//*****************************
+//*****************************
+#ifndef MEM_EXT_UNIO_SIM_C_INIT		//(Do only once)
+#define	MEM_EXT_UNIO_SIM_C_INIT
+
+#include <stdint.h>
+
+#define	UNIO_SIM_TIMER_COUNT_NS				50			//Virtual timer clock period (matches the 20MHz peripheral bus clock assumed by UNIO_EEPROM_TIMER_QUARTER_PERIOD)
+#define	UNIO_SIM_MAX_SIZE					2048		//Largest device that can be simulated (11LC160)
+#define	UNIO_SIM_MAX_DEVICES				8			//Buses that can be simulated (one device per bus, see unio_sim_port_tris etc)
+#define	UNIO_SIM_PAGE_SIZE					16
+#define	UNIO_SIM_DEFAULT_SIZE				128			//11LC010
+#define	UNIO_SIM_DEFAULT_WRITE_CYCLE_NS		4000000		//Typical write cycle (Twc max is 5mS)
+
+#define	UNIO_SIM_TSTBY_NS					600000		//Standby pulse time
+#define	UNIO_SIM_TSS_NS						10000		//Start header setup time
+#define	UNIO_SIM_THDR_NS					5000		//Start header low pulse time
+
+#define	UNIO_SIM_NO_CAPTURE					0xffff		//unio_sim_capture_read() return value when there are no more edges (UNIO_SCIO_NO_CAPTURE)
+
+//Device commands
+#define	UNIO_SIM_CMD_READ					0x03
+#define	UNIO_SIM_CMD_WRITE					0x6c
+#define	UNIO_SIM_CMD_WREN					0x96
+#define	UNIO_SIM_CMD_RDSR					0x05
+#define	UNIO_SIM_CMD_WRDI					0x91
+#define	UNIO_SIM_CMD_WRSR					0x6e
+#define	UNIO_SIM_CMD_ERAL					0x6d
+#define	UNIO_SIM_CMD_SETAL					0x67
+
+//Status register bits
+#define	UNIO_SIM_STATUS_WIP					0x01
+#define	UNIO_SIM_STATUS_WEL					0x02
+#define	UNIO_SIM_STATUS_BP					0x0c		//Block protect bits (BP1:BP0, 01 = upper 1/4, 10 = upper 1/2, 11 = all)
+
+typedef enum _UNIO_SIM_STATE
+{
+	UNIO_SIM_STANDBY_WAIT,			//After POR or an error - waiting for a standby pulse
+	UNIO_SIM_IDLE,					//Waiting for a start header
+	UNIO_SIM_HEADER_LOW,			//Seen the Thdr low period, waiting for the first bit of the start header
+	UNIO_SIM_ACTIVE					//Clocking bits
+} UNIO_SIM_STATE;
+
+typedef struct _UNIO_SIM_DEVICE
+{
+	//----- CONFIGURATION -----
+	uint16_t size;						//Bytes (power of 2)
+	uint32_t write_cycle_ns;
+	int32_t clock_skew_ppm;				//Error of the device's own clock when it drives the bus
+	uint32_t min_quarter_ns;			//Shortest quarter bit period the device (and bus) can follow, transactions faster than this fail (0 = no limit)
+	uint32_t glitch_byte;				//Output data byte number glitch_byte (unio_sim_stats.bytes_read count) with no mid bit edge in its last bit (0 = none)
+
+	//----- ARRAY & STATUS REGISTER -----
+	uint8_t memory[UNIO_SIM_MAX_SIZE];
+	uint8_t status;
+	uint8_t write_command;				//Command that started the current write cycle
+	uint8_t new_status;					//WRSR value, loaded at the end of the write cycle
+	uint64_t write_complete_time;
+	uint8_t page_buffer[UNIO_SIM_PAGE_SIZE];
+	uint8_t page_buffer_loaded[UNIO_SIM_PAGE_SIZE];
+	uint16_t page_address;
+
+	//----- BUS STATE -----
+	UNIO_SIM_STATE state;
+	uint64_t level_since;				//Time the line last changed level
+	uint8_t last_level;
+	uint8_t phase;						//Quarter within the current bit (0 - 3)
+	uint8_t bit_index;					//Bit within the current frame (0-7 data, 8 MAK, 9 SAK)
+	uint16_t frame_index;			//0 = start header, 1 = device address, 2 = command, 3+ = command specific
+	uint8_t first_half;
+	uint8_t shift_in;
+	uint8_t command;
+	uint16_t address;
+	uint8_t device_driving_bits;		//Number of bit periods still driven by us (or the NoSAK slot after the header), so not decoded
+	uint8_t end_of_transaction;			//Return to idle once device_driving_bits reaches 0
+
+	//----- DEVICE OUTPUT -----
+	uint64_t drive_start;
+	uint32_t drive_quarter_ns;
+	uint16_t drive_bits;				//Bits to output, MSB (bit drive_count - 1) first
+	uint8_t drive_count;
+	uint8_t drive_glitch;
+} UNIO_SIM_DEVICE;
+
+#define	unio_sim_device						(unio_sim_devices[0])		//The device on the single bus
+
+typedef struct _UNIO_SIM_STATS
+{
+	uint64_t elapsed_ns;				//Total virtual time
+	uint64_t bus_active_ns;				//Time from start header to end of each transaction
+	uint64_t write_cycle_ns;			//Time the device spent in internal write cycles
+	uint32_t quarter_periods;			//Timer roll overs
+	uint32_t transactions;				//Start headers accepted
+	uint32_t bytes_read;				//Data bytes output by the device (READ and RDSR)
+	uint32_t bytes_written;				//Data bytes received by the device (WRITE)
+	uint32_t write_cycles;
+	uint32_t bus_errors;				//Transactions aborted by the device (bad bit, timing fault, not allowed)
+	uint64_t int_disabled_ns;			//Time between unio_sim_disable_int() and unio_sim_enable_int() (DISABLE_INT / ENABLE_INT)
+	uint64_t int_disabled_max_ns;		//Longest single interrupt disabled period
+	uint32_t int_unmatched_enables;		//unio_sim_enable_int() calls with interrupts already enabled
+} UNIO_SIM_STATS;
+
+
+#endif
+
+
+//*******************************
+//*******************************
+//********** FUNCTIONS **********
+//*******************************
+//*******************************
+#ifdef MEM_EXT_UNIO_SIM_C
+//-----------------------------------
+//----- INTERNAL ONLY FUNCTIONS -----
+//-----------------------------------
+void unio_sim_advance_to (uint64_t time);
+void unio_sim_quarter_tick (void);
+void unio_sim_device_quarter_tick (uint8_t level);
+void unio_sim_bit_complete (uint8_t bit);
+void unio_sim_frame_complete (uint8_t mak);
+void unio_sim_drive (uint8_t output_byte, uint8_t data);
+void unio_sim_error (void);
+void unio_sim_update_write_cycle (void);
+void unio_sim_start_write_cycle (void);
+uint8_t unio_sim_is_protected (uint16_t address);
+uint8_t unio_sim_device_level (UNIO_SIM_DEVICE *device, uint64_t time);
+uint8_t unio_sim_scio_level (uint64_t time);
+
+
+//-----------------------------------------
+//----- INTERNAL & EXTERNAL FUNCTIONS -----
+//-----------------------------------------
+//(Also defined below as extern)
+void unio_sim_reset (void);
+void unio_sim_reset_stats (void);
+void unio_sim_open_timer (uint16_t period);
+void unio_sim_write_timer (uint16_t value);
+void unio_sim_clear_irq_flag (void);
+uint8_t unio_sim_read_irq_flag (void);
+void unio_sim_enable_timer_irq (void (*isr)(void));
+void unio_sim_idle_wait (void);
+void unio_sim_scio_tris (uint8_t input);
+void unio_sim_scio_output (uint8_t level);
+uint8_t unio_sim_scio_input (void);
+void unio_sim_port_tris (uint16_t input_mask);
+void unio_sim_port_output (uint16_t levels);
+uint16_t unio_sim_port_input (void);
+uint16_t unio_sim_capture_read (void);
+void unio_sim_disable_int (void);
+void unio_sim_enable_int (void);
+
+#else
+//------------------------------
+//----- EXTERNAL FUNCTIONS -----
+//------------------------------
+extern void unio_sim_reset (void);
+extern void unio_sim_reset_stats (void);
+extern void unio_sim_open_timer (uint16_t period);
+extern void unio_sim_write_timer (uint16_t value);
+extern void unio_sim_clear_irq_flag (void);
+extern uint8_t unio_sim_read_irq_flag (void);
+extern void unio_sim_enable_timer_irq (void (*isr)(void));
+extern void unio_sim_idle_wait (void);
+extern void unio_sim_scio_tris (uint8_t input);
+extern void unio_sim_scio_output (uint8_t level);
+extern uint8_t unio_sim_scio_input (void);
+extern void unio_sim_port_tris (uint16_t input_mask);
+extern void unio_sim_port_output (uint16_t levels);
+extern uint16_t unio_sim_port_input (void);
+extern uint16_t unio_sim_capture_read (void);
+extern void unio_sim_disable_int (void);
+extern void unio_sim_enable_int (void);
+void unio_sim_disable_int (void);
+void unio_sim_enable_int (void);
+
+#endif
+
+
+
+
+//****************************
+//****************************
+//********** MEMORY **********
+//****************************
+//****************************
+#ifdef MEM_EXT_UNIO_SIM_C
+//--------------------------------------------
+//----- INTERNAL ONLY MEMORY DEFINITIONS -----
+//--------------------------------------------
+uint64_t unio_sim_time;
+uint64_t unio_sim_next_tick;
+uint32_t unio_sim_quarter_ns;
+uint16_t unio_sim_timer_period;
+uint8_t unio_sim_irq_flag;
+void (*unio_sim_timer_isr)(void);
+uint16_t unio_sim_master_input;					//Bit per bus, 1 = master not driving
+uint16_t unio_sim_master_level;
+UNIO_SIM_DEVICE *unio_sim_dev;					//Device being clocked
+uint64_t unio_sim_period_start;					//Time the timer count was 0 for the current period
+uint64_t unio_sim_previous_period_start;
+uint64_t unio_sim_capture_time;					//Input capture has looked at SCIO up to this time
+uint8_t unio_sim_capture_level;
+uint8_t unio_sim_int_disabled;
+uint64_t unio_sim_int_disabled_time;
+
+
+//--------------------------------------------------
+//----- INTERNAL & EXTERNAL MEMORY DEFINITIONS -----
+//--------------------------------------------------
+//(Also defined below as extern)
+UNIO_SIM_DEVICE unio_sim_devices[UNIO_SIM_MAX_DEVICES];
+uint8_t unio_sim_device_count;					//Number of buses simulated (1 unless using the multi bus engine)
+UNIO_SIM_STATS unio_sim_stats;
+void (*unio_sim_disable_int_hook)(void);		//Optional, called by each unio_sim_disable_int() (cleared by unio_sim_reset())
+
+
+#else
+//---------------------------------------
+//----- EXTERNAL MEMORY DEFINITIONS -----
+//---------------------------------------
+extern UNIO_SIM_DEVICE unio_sim_devices[UNIO_SIM_MAX_DEVICES];
+extern uint8_t unio_sim_device_count;
+extern UNIO_SIM_STATS unio_sim_stats;
+extern void (*unio_sim_disable_int_hook)(void);
+
+
+#endif
@@ -37,6 +37,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "mem-11lcxxx.h"
 
+#if (defined(UNIO_USE_READ_CACHE) && (UNIO_READ_CACHE_READ_AHEAD >= UNIO_READ_CACHE_PAGES))
+#error "UNIO_READ_CACHE_READ_AHEAD must be less than UNIO_READ_CACHE_PAGES"
+#endif
+
 
 //**********************************************
 //**********************************************
@@ -49,8 +53,126 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 void unio_setup_timer_for_unio_use (void)
 {
 
-	OpenTimer2((T2_ON | T2_IDLE_CON | T2_GATE_OFF | T2_PS_1_1 | T2_SOURCE_INT), (uint16_t)UNIO_EEPROM_TIMER_QUARTER_PERIOD);		//<<SET PRx VALUE TO GIVE #uS ROLL OVER AND SETTING OF IRQ FLAG
+	if (!unio_quarter_period)
+		unio_set_bus_speed(UNIO_EEPROM_TIMER_QUARTER_PERIOD);		//First use - default bus speed
+
+	UNIO_EEPROM_OPEN_TIMER(unio_quarter_period);		//<<SET PRx VALUE TO GIVE #uS ROLL OVER AND SETTING OF IRQ FLAG (see mem-11lcxxx.h)
+#ifdef UNIO_USE_EDGE_DECODER
+	UNIO_SCIO_CAPTURE_OPEN();										//Input capture of SCIO edges against this timer
+#endif
+	unio_timer_is_ours = 1;
+}
+
+
+
+//***********************************
+//***********************************
+//********** TIMER SHARING **********
+//***********************************
+//***********************************
+//The timer may be shared with one other user.  The other user registers its period and interrupt handler, UNI/O then borrows the
+//timer for the length of each bus transaction (or standby pulse / delay) and hands it back afterwards with the other user's period
+//restored and its interrupt re-enabled.  If the other user has locked the timer UNI/O waits (blocking functions) or queues
+//(interrupt driven engine) until it is unlocked.
+//If no other user is registered the timer is setup once and kept.
+
+//Register the other user of the timer.  period is the value for UNIO_EEPROM_OPEN_TIMER, isr (may be null) is called by unio_timer_isr()
+//while the other user has the timer (the IRQ flag is already cleared).  A period of 0 ends the sharing (the timer is setup for UNI/O
+//again at its next use).
+void unio_timer_other_register (uint16_t period, void (*isr)(void))
+{
+	UNIO_EEPROM_DISABLE_TIMER_IRQ();
+	unio_timer_other_period = period;
+	unio_timer_other_isr = isr;
+	unio_timer_other_registered = 1;
+	if (!period)
+	{
+		unio_timer_other_isr = 0;
+		unio_timer_other_registered = 0;
+	}
+
+	if (unio_timer_users)
+		UNIO_EEPROM_ENABLE_TIMER_IRQ();			//(Interrupt driven engine has the timer)
+	else if (unio_timer_other_registered)
+		unio_timer_give_back();
+}
+
+//The other user needs the timer and must not be interrupted by UNI/O using it
+void unio_timer_other_lock (void)
+{
+	unio_timer_other_locked = 1;
+}
+
+void unio_timer_other_unlock (void)
+{
+	unio_timer_other_locked = 0;
+
+#ifdef UNIO_USE_IRQ_ENGINE
+	//----- START ANY TRANSACTION QUEUED WHILE LOCKED -----
+	UNIO_EEPROM_DISABLE_TIMER_IRQ();
+	if ((unio_irq_current) && (unio_irq_state == UNIO_IRQ_STATE_IDLE))
+	{
+		unio_timer_acquire();
+		unio_irq_start_transaction();
+		UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	}
+	if ((unio_irq_current) || (unio_timer_other_isr))
+		UNIO_EEPROM_ENABLE_TIMER_IRQ();
+#endif
+}
+
+
+//Take the timer for UNI/O (calls may be nested)
+void unio_timer_acquire (void)
+{
+	if (unio_timer_users++)
+		return;
+
+	while (unio_timer_other_locked)
+		UNIO_EEPROM_IDLE_WAIT();
+
+	if (!unio_timer_is_ours)
+	{
+		UNIO_EEPROM_DISABLE_TIMER_IRQ();
+		unio_setup_timer_for_unio_use();
+	}
+}
+
+//Hand the timer back once the last nested user is done
+void unio_timer_release (void)
+{
+	if ((!unio_timer_users) || (--unio_timer_users))
+		return;
+
+	if (unio_timer_other_registered)
+		unio_timer_give_back();
+}
+
+void unio_timer_give_back (void)
+{
+	unio_timer_is_ours = 0;
+	UNIO_EEPROM_OPEN_TIMER(unio_timer_other_period);
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	if (unio_timer_other_isr)
+		UNIO_EEPROM_ENABLE_TIMER_IRQ();
+	else
+		UNIO_EEPROM_DISABLE_TIMER_IRQ();
+}
+
 
+//Call from the timer interrupt when the timer is shared, or when using the interrupt driven engine
+void unio_timer_isr (void)
+{
+#ifdef UNIO_USE_IRQ_ENGINE
+	if (unio_irq_state != UNIO_IRQ_STATE_IDLE)
+	{
+		unio_irq_tick();
+		return;
+	}
+#endif
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	if ((!unio_timer_users) && (unio_timer_other_isr))
+		unio_timer_other_isr();
 }
 
 
@@ -63,18 +185,29 @@ void unio_setup_timer_for_unio_use (void)
 //Min 5uS, may produce longer delay for slower bus speeds (timer is only used for min times, longer times don't matter)
 void unio_delay_5us (uint16_t delay_5us)
 {
+	unio_timer_acquire();
+	unio_delay_quarters((uint32_t)delay_5us * unio_quarters_per_5us);
+	unio_timer_release();
+}
+
+//Waits for the next timer roll over and then for # further quarter bit periods
+void unio_delay_quarters (uint32_t quarters)
+{
+	unio_timer_acquire();
+	unio_bus_ticks += quarters + 1;
 
 	while (!UNIO_EEPROM_READ_IRQ_FLAG())
 		;
 	UNIO_EEPROM_CLEAR_IRQ_FLAG();
 
-	while (delay_5us)
+	while (quarters)
 	{
 		while (!UNIO_EEPROM_READ_IRQ_FLAG())
 			;
 		UNIO_EEPROM_CLEAR_IRQ_FLAG();
-		delay_5us--;
+		quarters--;
 	}
+	unio_timer_release();
 }
 
 
@@ -82,6 +215,37 @@ void unio_delay_5us (uint16_t delay_5us)
 
 
 
+//***********************************
+//***********************************
+//********** SET BUS SPEED **********
+//***********************************
+//***********************************
+//quarter_period is the timer period (value for UNIO_EEPROM_OPEN_TIMER) between UNIO_EEPROM_TIMER_MIN_QUARTER_PERIOD (100kHz) and
+//UNIO_EEPROM_TIMER_QUARTER_PERIOD.  Takes effect from the next bus transaction.  The min times (Tss, Thdr, Tstby) are counted in
+//quarter bit periods so are scaled to stay at least 5uS per unit at fast speeds, and the learnt write cycle times are discarded.
+void unio_set_bus_speed (uint16_t quarter_period)
+{
+	uint32_t quarter_ns;
+	uint8_t band;
+
+	if (quarter_period < UNIO_EEPROM_TIMER_MIN_QUARTER_PERIOD)
+		quarter_period = UNIO_EEPROM_TIMER_MIN_QUARTER_PERIOD;
+	if (quarter_period > UNIO_EEPROM_TIMER_QUARTER_PERIOD)
+		quarter_period = UNIO_EEPROM_TIMER_QUARTER_PERIOD;
+
+	unio_quarter_period = quarter_period;
+	quarter_ns = (uint32_t)quarter_period * UNIO_EEPROM_TIMER_COUNT_NS;
+	unio_quarters_per_5us = (uint8_t)((5000 + quarter_ns - 1) / quarter_ns);
+
+	for (band = 0; band < UNIO_WRITE_CYCLE_BANDS; band++)
+		unio_write_cycle_ticks[band] = 0;			//Learnt in quarter bit periods, so relearn
+
+	if (!unio_timer_users)
+		unio_timer_is_ours = 0;						//Setup again with the new period when next acquired
+}
+
+
+
 //*****************************************
 //*****************************************
 //********** INITIALISE UNIO BUS **********
@@ -93,13 +257,18 @@ void unio_eeprom_init (void)
 	UNIO_SCIO_OUTPUT(0);
 
 	//Setup the timer ready for us to use
-	unio_setup_timer_for_unio_use();
+	unio_timer_acquire();
 
 	unio_delay_5us(1);				//Delay to ensure minimum pulse width of 125 ns
 
 	UNIO_SCIO_OUTPUT(1);			//Bring high to release from POR
 
 	unio_delay_5us(120);			//Hold SCIO high for min 600uS (Tstby) to generate standby pulse.
+	unio_timer_release();
+
+#ifdef UNIO_USE_READ_CACHE
+	unio_read_cache_invalidate();
+#endif
 }
 
 
@@ -114,6 +283,18 @@ void unio_eeprom_init (void)
 //	1 if present, 0 if not present
 BYTE unio_is_eeprom_present (void)
 {
+#ifdef UNIO_USE_IRQ_ENGINE
+	UNIO_TRANSACTION transaction;
+	uint8_t status;
+
+	unio_stats.presence_checks++;
+	unio_irq_load_transaction(&transaction, 0b00000101, 0, 0);		//RDSR command
+	transaction.rx_data = &status;
+	transaction.rx_length = 1;
+	return(unio_irq_run(&transaction));
+#else
+	unio_stats.presence_checks++;
+	unio_timer_acquire();
 	unio_delay_5us(2);						//Observe Tss time (min 10uS, no max)
 
 	//----- HEADER -----
@@ -126,6 +307,7 @@ BYTE unio_is_eeprom_present (void)
 	if (!unio_input_bit_read)				//Got SAK?
 	{
 		unio_idle();
+		unio_timer_release();
 		return(0);
 	}
 
@@ -140,7 +322,9 @@ BYTE unio_is_eeprom_present (void)
 	unio_ack_sequence();
 
 	unio_idle();
+	unio_timer_release();
 	return(1);
+#endif
 }
 
 
@@ -149,87 +333,73 @@ BYTE unio_is_eeprom_present (void)
 //********** EEPROM READ **********
 //*********************************
 //*********************************
+//Reads are not limited to a page - the whole range is streamed in a single READ transaction as the device auto increments its
+//address across the entire array, so each byte after the first 4 header bytes costs only 10 bit periods.  The range must be within
+//the device (UNIO_EEPROM_SIZE), the device would roll over to 0x0000 after the last byte.
+//If a transaction fails part way through the retry carries on from the first byte that wasn't read, not from the start.
+//With UNIO_USE_READ_CACHE short reads are served from the read cache where possible.
 //Returns:
 //	1 is sucessful, 0 if failed (all bytes will be set to 0x00)
-BYTE unio_eeprom_read (uint16_t address, uint8_t *data, uint8_t length)
+BYTE unio_eeprom_read (uint16_t address, uint8_t *data, uint16_t length)
 {
-	uint8_t count;
-	uint8_t retry_count = 3;
-	
-
-	if (length < 1)
-		return;
-
-	if (length > UNIO_EEPROM_PAGE_SIZE)
-		length = UNIO_EEPROM_PAGE_SIZE;
-
-	while (retry_count--)
-	{
-		unio_comms_error = 0;
-		
-		DISABLE_INT;
-		unio_delay_5us(2);						//Observe Tss time (min 10uS, no max)
+#ifdef UNIO_USE_READ_CACHE
+	return(unio_read_cache_read(address, data, length));
+#else
+	return(unio_eeprom_read_device(address, data, length));
+#endif
+}
 
-		//----- HEADER -----
-		unio_start_header();
 
-		//----- DEVICE ADDRESS -----
-		unio_data_out = UNIO_EEPROM_ADDRESS;
-		unio_output_byte();
-		if (!unio_input_bit_read)				//Got SAK?
-			unio_comms_error = 1;
 
-		//----- COMMAND -----
-		unio_data_out = 0b00000011;				//READ command
-		unio_output_byte();
-		if (!unio_input_bit_read)				//Got SAK?
-			unio_comms_error = 1;
+//****************************************
+//****************************************
+//********** EEPROM READ DEVICE **********
+//****************************************
+//****************************************
+//unio_eeprom_read() without the read cache, for reads that must come from the device (write read back, calibration)
+BYTE unio_eeprom_read_device (uint16_t address, uint8_t *data, uint16_t length)
+{
+	uint16_t count;
+	uint16_t offset = 0;
+	uint16_t chunk_length;
+	uint8_t retry_count = 3;
+	
 
-		//----- START ADDRESS H -----
-		unio_data_out = (uint8_t)((address & 0xff00) >> 8);
-		unio_output_byte();
-		if (!unio_input_bit_read)				//Got SAK?
-			unio_comms_error = 1;
+	if ((length < 1) || (((uint32_t)address + length) > UNIO_EEPROM_SIZE))
+		return(0);
 
-		//----- START ADDRESS L -----
-		unio_data_out = (uint8_t)(address & 0x00ff);
-		unio_output_byte();
-		if (!unio_input_bit_read)				//Got SAK?
-			unio_comms_error = 1;
+	unio_stats.reads++;
+	while (retry_count)
+	{
+		chunk_length = unio_int_off_max_bytes(5);		//(Split into several READ transactions if unio_int_off_budget_us is set)
+		if (chunk_length > (length - offset))
+			chunk_length = length - offset;
 
-		//----- DATA BYTES -----
-		unio_read_error = 0;
-		for (count = 0; count < length; count++)
+		if (unio_eeprom_read_once((address + offset), &data[offset], chunk_length))
 		{
-			unio_input_byte();
-			data[count] = unio_data_in;
-			if (count < (length - 1))
-				unio_send_mak = 1;
-			else
-				unio_send_mak = 0;
-			unio_ack_sequence();
-			if (!unio_input_bit_read)				//Got SAK?
-				unio_comms_error = 1;
+			unio_speed_feedback(1);
+			offset += chunk_length;
+			if (offset >= length)
+				return(1);
+			continue;
 		}
-		if (unio_read_error)
-			unio_comms_error = 1;
-
-		unio_idle();
-		ENABLE_INT;
-
-		if (unio_comms_error)
+		//There was a read error, try again from the first byte not read
+		unio_speed_feedback(0);
+		if (unio_read_good_length)
 		{
-			//There was a read error, try again
-			unio_standby_pulse();
-			continue;
+			offset += unio_read_good_length;
+			retry_count = 3;					//(Progress was made, so 3 more tries for the rest)
 		}
-
-		//----- SUCCESS ALL DONE -----
-		return(1);
-
+		else
+		{
+			retry_count--;
+		}
+		if (retry_count)
+			unio_stats.read_retries++;
 	}
+
 	//----- FAILED -----
-	ENABLE_INT;
+	unio_stats.failures++;
 	for (count = 0; count < length; count++)
 	{
 		data[count] = 0x00;
@@ -238,182 +408,1511 @@ BYTE unio_eeprom_read (uint16_t address, uint8_t *data, uint8_t length)
 }
 
 
-//**********************************
-//**********************************
-//********** EEPROM WRITE **********
-//**********************************
-//**********************************
-//Pages of 16 bytes may be written in a single operation, but they must be within the same 16 byte page (0x00-0x0F, 0x10-0x1F, etc)
+
+//**************************************
+//**************************************
+//********** EEPROM READ ONCE **********
+//**************************************
+//**************************************
+//A single READ transaction attempt, no retries.  The transaction stops at the first missing SAK (a standby pulse is then sent ready
+//for the next attempt) or at the first byte that didn't decode (ended with a NoMAK, so no standby pulse is needed).
 //Returns:
-//	1 is sucessful, 0 if failed
-BYTE unio_eeprom_write (uint16_t address, uint8_t *data, uint8_t length)
+//	1 is sucessful, 0 if failed (data contents undefined after the first unio_read_good_length bytes, which were read correctly)
+BYTE unio_eeprom_read_once (uint16_t address, uint8_t *data, uint16_t length)
 {
-	uint8_t count;
-	uint8_t retry_count = 3;
+#ifdef UNIO_USE_IRQ_ENGINE
+	UNIO_TRANSACTION transaction;
+	BYTE success;
+
+	unio_irq_load_transaction(&transaction, 0b00000011, 1, address);		//READ command
+	transaction.rx_data = data;
+	transaction.rx_length = length;
+	success = unio_irq_run(&transaction);		//(The engine sends the standby pulse itself before the next transaction)
+	unio_read_good_length = transaction.rx_done;
+	return(success);
+#else
+	uint16_t count;
+
+#ifdef UNIO_USE_ENCODED_FRAMES
+	unio_encode_begin();
+	unio_encode_byte(UNIO_EEPROM_ADDRESS, 1);
+	unio_encode_byte(0b00000011, 1);			//READ command
+	unio_encode_byte((uint8_t)((address & 0xff00) >> 8), 1);
+	unio_encode_byte((uint8_t)(address & 0x00ff), 1);
+#endif
+	unio_comms_error = 0;
+	unio_read_good_length = 0;
 	
+	unio_timer_acquire();
+	DISABLE_INT;
+	unio_stats_int_off_begin();
+	unio_delay_5us(2);						//Observe Tss time (min 10uS, no max)
 
-	if (length < 1)
-		return;
+#ifdef UNIO_USE_ENCODED_FRAMES
+	//----- HEADER, DEVICE ADDRESS, COMMAND, START ADDRESS -----
+	if (!unio_encoded_play())
+		unio_comms_error = 1;
+#else
+	//----- HEADER -----
+	unio_start_header();
 
-	if (length > UNIO_EEPROM_PAGE_SIZE)
-		length = UNIO_EEPROM_PAGE_SIZE;
+	//----- DEVICE ADDRESS -----
+	unio_output_byte_checked(UNIO_EEPROM_ADDRESS);
 
-	while (retry_count--)
-	{
-		unio_comms_error = 0;
-		DISABLE_INT;
-		//----- ENABLE WRITES -----
-		unio_write_enable();
-		unio_delay_5us(2);							//Observe Tss time (min 10uS, no max)
+	//----- COMMAND -----
+	unio_output_byte_checked(0b00000011);		//READ command
 
-		//----- HEADER -----
-		unio_start_header();
+	//----- START ADDRESS H -----
+	unio_output_byte_checked((uint8_t)((address & 0xff00) >> 8));
 
-		//----- DEVICE ADDRESS -----
-		unio_data_out = UNIO_EEPROM_ADDRESS;		//Load DEVICE_ADDR into unio_data_out
-		unio_output_byte();
-		if (!unio_input_bit_read)					//Got SAK?
-			unio_comms_error = 1;
+	//----- START ADDRESS L -----
+	unio_output_byte_checked((uint8_t)(address & 0x00ff));
+#endif
 
-		//----- COMMAND -----
-		unio_data_out = 0b01101100;					//WRITE command
-		unio_output_byte();
-		if (!unio_input_bit_read)					//Got SAK?
+	//----- DATA BYTES -----
+	unio_read_error = 0;
+	for (count = 0; (count < length) && (!unio_comms_error); count++)
+	{
+		unio_input_byte();
+		data[count] = unio_data_in;
+		if ((count < (length - 1)) && (!unio_read_error))
+			unio_send_mak = 1;
+		else
+			unio_send_mak = 0;					//(NoMAK also ends the read early if the byte didn't decode, leaving the device idle)
+		unio_ack_sequence();
+		if (!unio_input_bit_read)				//Got SAK?
 			unio_comms_error = 1;
+		else if (unio_read_error)
+			break;
+		else
+			unio_read_good_length = count + 1;
+	}
 
-		//----- START ADDRESS H -----
-		unio_data_out = (BYTE)((address & 0xff00) >> 8);	//Address MSB
-		unio_output_byte();
-		if (!unio_input_bit_read)					//Got SAK?
-			unio_comms_error = 1;
+	unio_idle();
+	unio_stats_int_off_end();
+	ENABLE_INT;
+	unio_timer_release();
 
-		//----- START ADDRESS L -----
-		unio_data_out = (BYTE)(address & 0x00ff);	//Address LSB
-		unio_output_byte();
-		if (!unio_input_bit_read)					//Got SAK?
-			unio_comms_error = 1;
+	if (unio_comms_error)
+	{
+		unio_standby_pulse();				//Missing SAK - the device needs a standby pulse before it will respond again
+		return(0);
+	}
+	if (unio_read_error)
+		return(0);							//Ended with a NoMAK, so only Tss is needed before the next transaction
+	return(1);
+#endif
+}
 
-		//----- DATA BYTES -----
-		for (count = 0; count < length; count++)
-		{
-			unio_data_out = data[count];
-			if (count < (length - 1))
-				unio_send_mak = 1;
-			else
-				unio_send_mak = 0;						//Send NoMAK on last byte to trigger write
-			unio_output_byte();
-			if (!unio_input_bit_read)					//Got SAK?
-				unio_comms_error = 1;
-		}
 
-		unio_idle();
+#ifdef UNIO_USE_READ_CACHE
+//********************************
+//********************************
+//********** READ CACHE **********
+//********************************
+//********************************
+//Reads covering up to (1 + UNIO_READ_CACHE_READ_AHEAD) pages are served from the cache, any page not cached is fetched with the
+//following read ahead pages in a single sequential READ.  Longer reads go straight to the device (a single READ, and the cache isn't
+//flushed by one-off bulk reads).
+//Returns:
+//	1 is sucessful, 0 if failed (all bytes will be set to 0x00)
+BYTE unio_read_cache_read (uint16_t address, uint8_t *data, uint16_t length)
+{
+	uint16_t page;
+	uint16_t last_page;
+	uint16_t page_address;
+	uint16_t count;
+	uint8_t slot;
 
-		unio_wait_for_write_complete();				//Perform WIP Polling
-		ENABLE_INT;
 
-		if (unio_comms_error)
+	if ((length < 1) || (((uint32_t)address + length) > UNIO_EEPROM_SIZE))
+		return(0);
+
+	page = address / UNIO_EEPROM_PAGE_SIZE;
+	last_page = (address + length - 1) / UNIO_EEPROM_PAGE_SIZE;
+	if ((last_page - page) > UNIO_READ_CACHE_READ_AHEAD)
+		return(unio_eeprom_read_device(address, data, length));
+
+	for ( ; page <= last_page; page++)
+	{
+		//----- FIND THE PAGE -----
+		for (slot = 0; slot < UNIO_READ_CACHE_PAGES; slot++)
 		{
-			//There was a write error, try again
-			continue;
+			if (unio_read_cache_page[slot] == page)
+				break;
 		}
-
-		//----- WRITE SUCCESS - NOW READ BACK AND VERIFY DATA WAS CORRECT -----
-		if (!unio_eeprom_read (address, &unio_temp_data_buffer[0], length))
+		if (slot < UNIO_READ_CACHE_PAGES)
 		{
-			//Read failed
-			unio_standby_pulse();
-			continue;
+			unio_stats.read_cache_hits++;
 		}
-
-		for (count = 0; count < length; count++)
+		else
 		{
-			if (unio_temp_data_buffer[count] != data[count])
+			unio_stats.read_cache_misses++;
+			slot = unio_read_cache_fetch(page);
+			if (slot >= UNIO_READ_CACHE_PAGES)
 			{
-				//READ VERIFY FAILED
-				unio_comms_error = 1;
-				break;
+				for (count = 0; count < length; count++)
+					data[count] = 0x00;
+				return(0);
 			}
 		}
-		if (unio_comms_error)
+
+		//----- MARK AS MOST RECENTLY USED -----
+		if (++unio_read_cache_clock == 0)
 		{
-			unio_standby_pulse();
-			continue;
+			//Clock wrapped - restart the ages (only the order matters)
+			for (count = 0; count < UNIO_READ_CACHE_PAGES; count++)
+				unio_read_cache_used[count] = 0;
+			unio_read_cache_clock = 1;
 		}
+		unio_read_cache_used[slot] = unio_read_cache_clock;
 
-
-		//----- SUCCESS ALL DONE -----
-		return(1);
+		//----- COPY THE BYTES IN THIS PAGE -----
+		page_address = page * UNIO_EEPROM_PAGE_SIZE;
+		for (count = address - page_address; (count < UNIO_EEPROM_PAGE_SIZE) && (length); count++, length--)
+			*data++ = unio_read_cache_data[((uint16_t)slot * UNIO_EEPROM_PAGE_SIZE) + count];
+		address = page_address + UNIO_EEPROM_PAGE_SIZE;
 	}
-	//----- FAILED -----
-	ENABLE_INT;
-	return(0);
+	return(1);
 }
 
 
+//Fetch page and the read ahead pages after it into the least recently used run of slots
+//Returns:
+//	Slot holding page, or UNIO_READ_CACHE_PAGES if the read failed
+uint8_t unio_read_cache_fetch (uint16_t page)
+{
+	uint8_t pages = 1 + UNIO_READ_CACHE_READ_AHEAD;
+	uint8_t slot;
+	uint8_t count;
+	uint8_t best_slot = 0;
+	uint16_t newest;
+	uint16_t best_newest = 0xffff;
 
+	if (pages > ((UNIO_EEPROM_SIZE / UNIO_EEPROM_PAGE_SIZE) - page))
+		pages = (uint8_t)((UNIO_EEPROM_SIZE / UNIO_EEPROM_PAGE_SIZE) - page);
 
+	//----- CHOOSE THE RUN OF SLOTS USED LEAST RECENTLY -----
+	for (slot = 0; slot <= (UNIO_READ_CACHE_PAGES - pages); slot++)
+	{
+		newest = 0;
+		for (count = 0; count < pages; count++)
+		{
+			if (unio_read_cache_used[slot + count] > newest)
+				newest = unio_read_cache_used[slot + count];
+		}
+		if (newest < best_newest)
+		{
+			best_newest = newest;
+			best_slot = slot;
+		}
+	}
 
+	//----- DROP ANY OTHER COPIES OF THE PAGES BEING FETCHED -----
+	for (slot = 0; slot < UNIO_READ_CACHE_PAGES; slot++)
+	{
+		if ((unio_read_cache_page[slot] >= page) && (unio_read_cache_page[slot] < (page + pages)))
+			unio_read_cache_page[slot] = UNIO_READ_CACHE_EMPTY;
+	}
+	for (count = 0; count < pages; count++)
+		unio_read_cache_page[best_slot + count] = UNIO_READ_CACHE_EMPTY;
 
+	//----- READ THEM IN ONE SEQUENTIAL READ -----
+	if (!unio_eeprom_read_device((page * UNIO_EEPROM_PAGE_SIZE), &unio_read_cache_data[(uint16_t)best_slot * UNIO_EEPROM_PAGE_SIZE], ((uint16_t)pages * UNIO_EEPROM_PAGE_SIZE)))
+		return(UNIO_READ_CACHE_PAGES);
 
+	for (count = 0; count < pages; count++)
+	{
+		unio_read_cache_page[best_slot + count] = page + count;
+		unio_read_cache_used[best_slot + count] = unio_read_cache_clock;		//(Read ahead pages count as used now, so they aren't the next to go)
+	}
+	return(best_slot);
+}
 
 
+//*******************************************
+//*******************************************
+//********** READ CACHE INVALIDATE **********
+//*******************************************
+//*******************************************
+//Empty the read cache.  Called by unio_eeprom_init(), and needed after changing the device contents with your own transactions
+//(unio_irq_submit()) - writes through the driver invalidate the pages they write.
+void unio_read_cache_invalidate (void)
+{
+	uint8_t slot;
 
+	for (slot = 0; slot < UNIO_READ_CACHE_PAGES; slot++)
+	{
+		unio_read_cache_page[slot] = UNIO_READ_CACHE_EMPTY;
+		unio_read_cache_used[slot] = 0;
+	}
+	unio_read_cache_clock = 0;
+}
 
 
-
-//**********************************
-//**********************************
-//********** WRITE ENABLE **********
-//**********************************
-//**********************************
-//Set the WEL bit in the Status Register.
-void unio_write_enable (void)
+//Drop any cached pages in address to (address + length - 1)
+void unio_read_cache_invalidate_range (uint16_t address, uint16_t length)
 {
-	unio_delay_5us(2);						//Observe Tss time (min 10uS, no max)
+	uint8_t slot;
+	uint16_t first_page = address / UNIO_EEPROM_PAGE_SIZE;
+	uint16_t last_page = (address + length - 1) / UNIO_EEPROM_PAGE_SIZE;
 
-	//----- HEADER -----
-    unio_start_header();
+	for (slot = 0; slot < UNIO_READ_CACHE_PAGES; slot++)
+	{
+		if ((unio_read_cache_page[slot] >= first_page) && (unio_read_cache_page[slot] <= last_page))
+		{
+			unio_read_cache_page[slot] = UNIO_READ_CACHE_EMPTY;
+			unio_read_cache_used[slot] = 0;
+		}
+	}
+}
+#endif
 
-	//----- DEVICE ADDRESS -----
-    unio_data_out = UNIO_EEPROM_ADDRESS;
-    unio_output_byte();
-	if (!unio_input_bit_read)				//Got SAK?
-		unio_comms_error = 1;
 
-	//----- COMMAND -----
-    unio_data_out = 0b10010110;				//WREN command
-    unio_send_mak = 0;
-    unio_output_byte();
-	if (!unio_input_bit_read)				//Got SAK?
-		unio_comms_error = 1;
 
-    unio_idle();
-}
+//*****************************************
+//*****************************************
+//********** CALIBRATE BUS SPEED **********
+//*****************************************
+//*****************************************
+//Probes the device at increasing bit rates, from UNIO_EEPROM_TIMER_QUARTER_PERIOD up to UNIO_EEPROM_TIMER_MIN_QUARTER_PERIOD in steps
+//of UNIO_SPEED_STEP_PERCENT.  At each rate UNIO_CALIBRATE_PROBES single attempt reads of the first page are made and checked against
+//a reference read at the slowest rate - any missing SAK, bad Manchester bit or wrong byte stops the search.  The bus is left at the
+//fastest good rate slowed by UNIO_CALIBRATE_MARGIN_PERCENT.  unio_speed_feedback() slows it down again if errors rise in use.
+//Returns:
+//	1 if calibrated, 0 if the device didn't respond at the slowest rate (left at the slowest rate)
+BYTE unio_calibrate_bus_speed (void)
+{
+	uint8_t reference[UNIO_EEPROM_PAGE_SIZE];
+	uint16_t period;
+	uint16_t fastest;
+	uint8_t probe;
+	uint8_t count;
+	uint8_t errors = 0;
 
+	unio_set_bus_speed(UNIO_EEPROM_TIMER_QUARTER_PERIOD);
+	if (!unio_eeprom_read_device(0x0000, &reference[0], UNIO_EEPROM_PAGE_SIZE))
+		return(0);
 
-//**********************************
-//**********************************
-//********** START HEADER **********
-//**********************************
-//**********************************
+	fastest = UNIO_EEPROM_TIMER_QUARTER_PERIOD;
+	while ((fastest > UNIO_EEPROM_TIMER_MIN_QUARTER_PERIOD) && (!errors))
+	{
+		period = fastest - (uint16_t)(((uint32_t)fastest * UNIO_SPEED_STEP_PERCENT) / 100);
+		unio_set_bus_speed(period);
+		period = unio_quarter_period;				//(Clamped)
+
+		for (probe = 0; probe < UNIO_CALIBRATE_PROBES; probe++)
+		{
+			if (!unio_eeprom_read_once(0x0000, &unio_temp_data_buffer[0], UNIO_EEPROM_PAGE_SIZE))
+			{
+				errors++;
+				continue;
+			}
+			for (count = 0; count < UNIO_EEPROM_PAGE_SIZE; count++)
+			{
+				if (unio_temp_data_buffer[count] != reference[count])
+				{
+					errors++;
+					break;
+				}
+			}
+		}
+		if (!errors)
+			fastest = period;
+	}
+
+	unio_set_bus_speed(fastest + (uint16_t)(((uint32_t)fastest * UNIO_CALIBRATE_MARGIN_PERCENT) / 100));
+	unio_standby_pulse();							//Device may have been left waiting for one by a failed probe
+	unio_speed_attempts = 0;
+	unio_speed_errors = 0;
+	return(1);
+}
+
+
+
+//************************************
+//************************************
+//********** SPEED FEEDBACK **********
+//************************************
+//************************************
+//Called with the result of each read or write attempt.  If more than UNIO_SPEED_MAX_ERRORS of UNIO_SPEED_WINDOW attempts fail the bus
+//is slowed by UNIO_SPEED_STEP_PERCENT (never slower than UNIO_EEPROM_TIMER_QUARTER_PERIOD).
+void unio_speed_feedback (BYTE success)
+{
+	if (!success)
+		unio_speed_errors++;
+
+	if (unio_speed_errors > UNIO_SPEED_MAX_ERRORS)
+	{
+		if (unio_quarter_period < UNIO_EEPROM_TIMER_QUARTER_PERIOD)
+			unio_set_bus_speed(unio_quarter_period + (uint16_t)(((uint32_t)unio_quarter_period * UNIO_SPEED_STEP_PERCENT) / 100) + 1);
+		unio_speed_attempts = 0;
+		unio_speed_errors = 0;
+		return;
+	}
+
+	if (++unio_speed_attempts >= UNIO_SPEED_WINDOW)
+	{
+		unio_speed_attempts = 0;
+		unio_speed_errors = 0;
+	}
+}
+
+
+
+//**********************************
+//**********************************
+//********** EEPROM WRITE **********
+//**********************************
+//**********************************
+//Pages of 16 bytes may be written in a single operation, but they must be within the same 16 byte page (0x00-0x0F, 0x10-0x1F, etc)
+//The data is verified as set by unio_verify_policy.  With UNIO_WRITE_SKIP_UNCHANGED nothing is written if the device already holds
+//the data.
+//Returns:
+//	1 is sucessful, 0 if failed
+BYTE unio_eeprom_write (uint16_t address, uint8_t *data, uint8_t length)
+{
+	if (unio_eeprom_write_report(address, data, length) == UNIO_WRITE_FAILED)
+		return(0);
+	return(1);
+}
+
+
+
+//*****************************************
+//*****************************************
+//********** EEPROM WRITE REPORT **********
+//*****************************************
+//*****************************************
+//As unio_eeprom_write(), but also reports whether a write cycle was needed.
+//Returns:
+//	UNIO_WRITE_DONE if written, UNIO_WRITE_SKIPPED if UNIO_WRITE_SKIP_UNCHANGED found the device already held the data, UNIO_WRITE_FAILED
+//	if failed
+uint8_t unio_eeprom_write_report (uint16_t address, uint8_t *data, uint8_t length)
+{
+	uint8_t count;
+	uint8_t retry_count = 3;
+	uint8_t read_back = 1;
+	
+
+	if (length < 1)
+		return(UNIO_WRITE_FAILED);
+
+	if (length > UNIO_EEPROM_PAGE_SIZE)
+		length = UNIO_EEPROM_PAGE_SIZE;
+
+	if ((((uint32_t)address + length) > UNIO_EEPROM_SIZE) || (((address & (UNIO_EEPROM_PAGE_SIZE - 1)) + length) > UNIO_EEPROM_PAGE_SIZE))
+		return(UNIO_WRITE_FAILED);
+
+#ifdef UNIO_WRITE_SKIP_UNCHANGED
+	//----- SKIP IF THE DEVICE ALREADY HOLDS THE DATA -----
+	if (unio_eeprom_compare(address, data, length) == length)
+	{
+		unio_stats.writes++;
+		unio_stats.writes_skipped++;
+		return(UNIO_WRITE_SKIPPED);				//(No write cycle, so no wear)
+	}
+#endif
+
+	//----- VERIFY POLICY -----
+	if (unio_verify_policy == UNIO_VERIFY_NONE)
+	{
+		read_back = 0;
+	}
+	else if (unio_verify_policy == UNIO_VERIFY_SAMPLED)
+	{
+		if (++unio_verify_sample_count < UNIO_VERIFY_SAMPLE_INTERVAL)
+			read_back = 0;
+		else
+			unio_verify_sample_count = 0;
+	}
+	else if (unio_verify_policy == UNIO_VERIFY_DEFERRED)
+	{
+		unio_verify_deferred_add(address, data, length);		//(Before writing, as any earlier write to the same bytes must be verified first)
+		read_back = 0;
+	}
+
+	unio_stats.writes++;
+	while (retry_count--)
+	{
+		if (retry_count < 2)
+			unio_stats.write_retries++;			//(Not the first attempt)
+
+		if (!unio_eeprom_write_page(address, data, length))
+		{
+			//There was a write error, try again
+			unio_speed_feedback(0);
+			unio_standby_pulse();
+			continue;
+		}
+
+		if (!read_back)
+			return(UNIO_WRITE_DONE);
+
+		//----- WRITE SUCCESS - NOW READ BACK AND VERIFY DATA WAS CORRECT -----
+		if (!unio_eeprom_read_device(address, &unio_temp_data_buffer[0], length))
+		{
+			//Read failed
+			unio_standby_pulse();
+			continue;
+		}
+
+		unio_comms_error = 0;					//(Not cleared by the interrupt driven engine)
+		for (count = 0; count < length; count++)
+		{
+			if (unio_temp_data_buffer[count] != data[count])
+			{
+				//READ VERIFY FAILED
+				unio_comms_error = 1;
+				break;
+			}
+		}
+		if (unio_comms_error)
+		{
+			unio_stats.verify_errors++;
+			unio_speed_feedback(0);
+			unio_standby_pulse();
+			continue;
+		}
+
+
+		//----- SUCCESS ALL DONE -----
+		return(UNIO_WRITE_DONE);
+	}
+	//----- FAILED -----
+	unio_stats.failures++;
+	return(UNIO_WRITE_FAILED);
+}
+
+
+//***************************************
+//***************************************
+//********** EEPROM WRITE PAGE **********
+//***************************************
+//***************************************
+//Single attempt at WREN, WRITE and WIP polling for data within one page.  No read back verify.  The page is always written in one
+//WRITE transaction and one write cycle, even if that WRITE is longer than unio_int_off_budget_us (see unio_int_off_budget_us).
+//Returns:
+//	1 if all SAKs received, 0 if there was a comms error
+BYTE unio_eeprom_write_page (uint16_t address, uint8_t *data, uint8_t length)
+{
+	if (!unio_eeprom_write_start(address, data, length))
+		return(0);
+	if (!unio_wait_for_write_complete())		//Perform WIP Polling
+		return(0);
+	return(1);
+}
+
+
+
+//****************************************
+//****************************************
+//********** EEPROM WRITE START **********
+//****************************************
+//****************************************
+//Sends WREN and WRITE for data within one page and returns as soon as the NoMAK that starts the internal write cycle has been sent.
+//Interrupts are only disabled for the two bus transactions, not for the write cycle (and are let in between them if
+//unio_int_off_budget_us is set, but the WRITE is always a single transaction however long it is).
+//The device will only respond to RDSR until the write cycle completes, use unio_eeprom_is_write_complete() to check for this before
+//the next access.  No read back verify.
+//Returns:
+//	1 if all SAKs received, 0 if there was a comms error (call unio_standby_pulse() before trying again) or the data would cross a page
+//	boundary or the end of the device (nothing sent)
+BYTE unio_eeprom_write_start (uint16_t address, uint8_t *data, uint8_t length)
+{
+#ifdef UNIO_USE_IRQ_ENGINE
+	UNIO_TRANSACTION transaction;
+#else
+	uint8_t count;
+#endif
+
+	if (length < 1)
+		return(0);
+
+	if (length > UNIO_EEPROM_PAGE_SIZE)
+		length = UNIO_EEPROM_PAGE_SIZE;
+
+	if ((((uint32_t)address + length) > UNIO_EEPROM_SIZE) || (((address & (UNIO_EEPROM_PAGE_SIZE - 1)) + length) > UNIO_EEPROM_PAGE_SIZE))
+		return(0);								//Device would wrap within the page
+
+#ifdef UNIO_USE_READ_CACHE
+	unio_read_cache_invalidate_range(address, length);
+#endif
+
+#ifdef UNIO_USE_IRQ_ENGINE
+	//----- ENABLE WRITES -----
+	unio_irq_load_transaction(&transaction, 0b10010110, 0, 0);		//WREN command
+	if (!unio_irq_run(&transaction))
+		return(0);
+
+	//----- WRITE -----
+	unio_irq_load_transaction(&transaction, 0b01101100, 1, address);	//WRITE command
+	transaction.tx_data = data;
+	transaction.tx_length = length;
+	if (!unio_irq_run(&transaction))
+		return(0);
+	unio_write_start_ticks = unio_bus_ticks;
+	return(1);
+#else
+	unio_comms_error = 0;
+#ifdef UNIO_USE_ENCODED_FRAMES
+	unio_encode_begin();
+	unio_encode_byte(UNIO_EEPROM_ADDRESS, 1);
+	unio_encode_byte(0b01101100, 1);			//WRITE command
+	unio_encode_byte((uint8_t)((address & 0xff00) >> 8), 1);
+	unio_encode_byte((uint8_t)(address & 0x00ff), 1);
+	for (count = 0; count < length; count++)
+		unio_encode_byte(data[count], (count < (length - 1)));		//NoMAK on last byte to trigger write
+#endif
+	unio_timer_acquire();
+	DISABLE_INT;
+	unio_stats_int_off_begin();
+	//----- ENABLE WRITES -----
+	unio_write_enable();
+	if ((unio_int_off_budget_us) && (!unio_comms_error))
+	{
+		//Let interrupts in between WREN and WRITE (the bus is idle, WEL stays set)
+		unio_stats_int_off_end();
+		ENABLE_INT;
+		DISABLE_INT;
+		unio_stats_int_off_begin();
+	}
+	if (!unio_comms_error)						//(Nothing more is sent after a missing SAK)
+		unio_delay_5us(2);						//Observe Tss time (min 10uS, no max)
+
+#ifdef UNIO_USE_ENCODED_FRAMES
+	//----- HEADER, DEVICE ADDRESS, COMMAND, START ADDRESS, DATA BYTES -----
+	if ((!unio_comms_error) && (!unio_encoded_play()))
+		unio_comms_error = 1;
+#else
+	//----- HEADER -----
+	if (!unio_comms_error)
+		unio_start_header();
+
+	//----- DEVICE ADDRESS -----
+	unio_output_byte_checked(UNIO_EEPROM_ADDRESS);
+
+	//----- COMMAND -----
+	unio_output_byte_checked(0b01101100);		//WRITE command
+
+	//----- START ADDRESS H -----
+	unio_output_byte_checked((BYTE)((address & 0xff00) >> 8));	//Address MSB
+
+	//----- START ADDRESS L -----
+	unio_output_byte_checked((BYTE)(address & 0x00ff));	//Address LSB
+
+	//----- DATA BYTES -----
+	for (count = 0; (count < length) && (!unio_comms_error); count++)
+	{
+		if (count < (length - 1))
+			unio_send_mak = 1;
+		else
+			unio_send_mak = 0;						//Send NoMAK on last byte to trigger write
+		unio_output_byte_checked(data[count]);		//(Stopping before the NoMAK means no write cycle is started)
+	}
+#endif
+
+	unio_idle();
+	unio_stats_int_off_end();
+	ENABLE_INT;
+	unio_timer_release();
+
+	if (unio_comms_error)
+		return(0);
+	unio_write_start_ticks = unio_bus_ticks;
+	return(1);
+#endif
+}
+
+
+
+//**********************************************
+//**********************************************
+//********** EEPROM IS WRITE COMPLETE **********
+//**********************************************
+//**********************************************
+//A single short RDSR transaction (header, device address, command and 1 status byte) to check the WIP bit.  Interrupts are only
+//disabled for this one transaction, so this may be called from a background task after unio_eeprom_write_start().
+//Returns:
+//	1 if the write cycle is complete, 0 if still in progress or the device didn't respond
+BYTE unio_eeprom_is_write_complete (void)
+{
+	uint8_t status;
+
+	if (!unio_eeprom_read_status(&status))
+		return(0);
+	return((status & UNIO_EEPROM_STATUS_WIP) ? 0 : 1);
+}
+
+
+
+//****************************************
+//****************************************
+//********** EEPROM READ STATUS **********
+//****************************************
+//****************************************
+//RDSR - reads the status register (UNIO_EEPROM_STATUS_WIP, UNIO_EEPROM_STATUS_WEL, UNIO_EEPROM_STATUS_BP0 and UNIO_EEPROM_STATUS_BP1).
+//May be used during a write cycle.
+//Returns:
+//	1 if sucessful, 0 if the device didn't respond (status is not altered)
+BYTE unio_eeprom_read_status (uint8_t *status)
+{
+	uint8_t value = 0x01;
+#ifdef UNIO_USE_IRQ_ENGINE
+	UNIO_TRANSACTION transaction;
+
+	unio_irq_load_transaction(&transaction, 0b00000101, 0, 0);		//RDSR command
+	transaction.rx_data = &value;
+	transaction.rx_length = 1;
+	if (!unio_irq_run(&transaction))
+		return(0);
+	*status = value;
+	return(1);
+#else
+	unio_comms_error = 0;
+
+	unio_timer_acquire();
+	DISABLE_INT;
+	unio_stats_int_off_begin();
+	unio_delay_5us(2);						//Observe Tss time (min 10uS, no max)
+
+	//----- HEADER -----
+	unio_start_header();
+
+	//----- DEVICE ADDRESS -----
+	unio_output_byte_checked(UNIO_EEPROM_ADDRESS);
+
+	//----- COMMAND -----
+	unio_output_byte_checked(0b00000101);		//RDSR command
+
+	//----- STATUS REGISTER -----
+	if (!unio_comms_error)
+	{
+		unio_read_error = 0;
+		unio_input_byte();
+		value = unio_data_in;					//(unio_data_in bit 0 is overwritten by the SAK)
+		unio_send_mak = 0;
+		unio_ack_sequence();
+		if ((!unio_input_bit_read) || (unio_read_error))
+			unio_comms_error = 1;
+	}
+
+	unio_idle();
+	unio_stats_int_off_end();
+	ENABLE_INT;
+	unio_timer_release();
+
+	if (unio_comms_error)
+	{
+		unio_standby_pulse();				//Device needs a standby pulse before it will respond again
+		return(0);
+	}
+	*status = value;
+	return(1);
+#endif
+}
+
+
+
+//***************************************
+//***************************************
+//********** EEPROM WRITE BULK **********
+//***************************************
+//***************************************
+//Writes any address range.  The data is split at page boundaries (unaligned first and last pages are written as partial pages) and
+//each page is programmed with just WREN, WRITE and WIP polling.  The whole range is then verified in a single sequential read rather
+//than a read back after every page (as set by unio_verify_policy - with UNIO_VERIFY_SAMPLED each page counts as a write towards the
+//sample interval and with UNIO_VERIFY_DEFERRED each page is stored for unio_eeprom_verify_deferred() instead).  A page that didn't
+//verify is written again and the verify carries on from it, so only the pages that differ are rewritten.
+//result (optional, may be null) is loaded with the number of page write cycles used and the bus time taken.
+//Returns:
+//	1 is sucessful, 0 if failed or the range is past the end of the device
+BYTE unio_eeprom_write_bulk (uint16_t address, uint8_t *data, uint16_t length, UNIO_BULK_WRITE_RESULT *result)
+{
+	uint16_t offset = 0;
+	uint16_t page_offset;
+	uint16_t failed_page = 0xffff;
+	uint8_t page_length;
+	uint8_t retry_count = 3;
+	uint16_t pages_written = 0;
+	uint32_t start_ticks = unio_bus_ticks;
+	uint8_t read_back = 1;
+	BYTE success = 0;
+
+
+	if (((uint32_t)address + length) > UNIO_EEPROM_SIZE)
+		length = 0;
+
+	unio_stats.bulk_writes++;
+
+	//----- WRITE EACH PAGE -----
+	while ((offset < length) && (retry_count))
+	{
+		page_length = UNIO_EEPROM_PAGE_SIZE - ((address + offset) & (UNIO_EEPROM_PAGE_SIZE - 1));
+		if (page_length > (length - offset))
+			page_length = (uint8_t)(length - offset);
+
+		if ((unio_verify_policy == UNIO_VERIFY_DEFERRED) && (retry_count == 3))
+			unio_verify_deferred_add((address + offset), &data[offset], page_length);		//(First attempt at this page)
+
+		pages_written++;
+		if (!unio_eeprom_write_page((address + offset), &data[offset], page_length))
+		{
+			//Page write failed - try again from the same page
+			unio_standby_pulse();
+			retry_count--;
+			if (retry_count)
+				unio_stats.write_retries++;
+			continue;
+		}
+		offset += page_length;
+		retry_count = 3;
+	}
+
+	//----- VERIFY POLICY -----
+	if ((unio_verify_policy == UNIO_VERIFY_NONE) || (unio_verify_policy == UNIO_VERIFY_DEFERRED))
+	{
+		read_back = 0;
+	}
+	else if (unio_verify_policy == UNIO_VERIFY_SAMPLED)
+	{
+		//Each page counts as a write towards the sample interval
+		if (((uint16_t)unio_verify_sample_count + pages_written) < UNIO_VERIFY_SAMPLE_INTERVAL)
+		{
+			unio_verify_sample_count += (uint8_t)pages_written;
+			read_back = 0;
+		}
+		else
+		{
+			unio_verify_sample_count = 0;
+		}
+	}
+
+	//----- VERIFY THE WHOLE RANGE -----
+	if ((length) && (offset >= length) && (!read_back))
+	{
+		success = 1;
+		length = 0;
+	}
+	offset = 0;
+	while ((offset < length) && (retry_count))
+	{
+		offset += unio_eeprom_verify((address + offset), &data[offset], (length - offset));
+		if (offset >= length)
+		{
+			success = 1;
+			break;
+		}
+		if (unio_comms_error)
+		{
+			//Couldn't be read - try again from the first byte not verified
+			retry_count--;
+			if (retry_count)
+				unio_stats.read_retries++;
+			continue;
+		}
+		unio_standby_pulse();
+
+		//Write the page that failed again, then carry on verifying from its start
+		page_offset = offset - ((address + offset) & (UNIO_EEPROM_PAGE_SIZE - 1));
+		if (page_offset > offset)
+			page_offset = 0;					//First page was a partial page
+		if (page_offset != failed_page)
+			retry_count = 3;					//(A different page, so 3 tries for it)
+		failed_page = page_offset;
+		unio_stats.verify_errors++;
+		retry_count--;
+		if (!retry_count)
+			break;
+		unio_stats.write_retries++;
+
+		page_length = UNIO_EEPROM_PAGE_SIZE - ((address + page_offset) & (UNIO_EEPROM_PAGE_SIZE - 1));
+		if (page_length > (length - page_offset))
+			page_length = (uint8_t)(length - page_offset);
+		pages_written++;
+		if (!unio_eeprom_write_page((address + page_offset), &data[page_offset], page_length))
+			unio_standby_pulse();				//(Found again by the verify)
+		offset = page_offset;
+	}
+
+	if (result)
+	{
+		result->pages_written = pages_written;
+		result->bus_ticks = unio_bus_ticks - start_ticks;
+	}
+	if (!success)
+		unio_stats.failures++;
+	return(success);
+}
+
+
+
+//**************************************
+//**************************************
+//********** EEPROM ERASE ALL **********
+//**************************************
+//**************************************
+//ERAL - sets every byte in the device to 0x00 in a single write cycle (the same time as one page write), including WIP polling.
+//The device ignores ERAL if any block is write protected, so the BP bits are checked first.  No read back verify.  Any
+//unio_eeprom_verify_deferred() records for the old data will now fail, and a RAM cache must be reloaded (unio_cache_load()).
+//Returns:
+//	1 is sucessful, 0 if failed or blocks are protected (nothing sent)
+BYTE unio_eeprom_erase_all (void)
+{
+	return(unio_eeprom_fill_all(0b01101101));		//ERAL command
+}
+
+
+
+//************************************
+//************************************
+//********** EEPROM SET ALL **********
+//************************************
+//************************************
+//SETAL - as unio_eeprom_erase_all() but sets every byte to 0xFF
+BYTE unio_eeprom_set_all (void)
+{
+	return(unio_eeprom_fill_all(0b01100111));		//SETAL command
+}
+
+
+
+//*************************************
+//*************************************
+//********** EEPROM FILL ALL **********
+//*************************************
+//*************************************
+BYTE unio_eeprom_fill_all (uint8_t command)
+{
+	uint8_t status;
+
+	if (!unio_eeprom_read_status(&status))
+		return(0);
+	if (status & (UNIO_EEPROM_STATUS_BP0 | UNIO_EEPROM_STATUS_BP1))
+		return(0);
+
+#ifdef UNIO_USE_READ_CACHE
+	unio_read_cache_invalidate();
+#endif
+
+	unio_stats.writes++;
+	if (!unio_eeprom_write_cycle_command(command, 0, 0))
+	{
+		unio_stats.failures++;
+		return(0);
+	}
+	return(1);
+}
+
+
+
+//******************************************
+//******************************************
+//********** EEPROM WRITE PROTECT **********
+//******************************************
+//******************************************
+//WRSR - sets the block protect bits, including WIP polling.  block_protect is one of UNIO_EEPROM_PROTECT_NONE,
+//UNIO_EEPROM_PROTECT_UPPER_QUARTER, UNIO_EEPROM_PROTECT_UPPER_HALF or UNIO_EEPROM_PROTECT_ALL.  WRITE, ERAL and SETAL to a
+//protected block are ignored by the device (unio_eeprom_write() will fail its read back verify).  The status register is read
+//back to confirm the new setting.
+//Returns:
+//	1 is sucessful, 0 if failed
+BYTE unio_eeprom_write_protect (uint8_t block_protect)
+{
+	uint8_t status;
+
+	block_protect &= (UNIO_EEPROM_STATUS_BP0 | UNIO_EEPROM_STATUS_BP1);
+
+	if (!unio_eeprom_write_cycle_command(0b01101110, &block_protect, 1))		//WRSR command
+		return(0);
+
+	if (!unio_eeprom_read_status(&status))
+		return(0);
+	return(((status & (UNIO_EEPROM_STATUS_BP0 | UNIO_EEPROM_STATUS_BP1)) == block_protect) ? 1 : 0);
+}
+
+
+
+//******************************************
+//******************************************
+//********** EEPROM WRITE DISABLE **********
+//******************************************
+//******************************************
+//WRDI - clears the write enable latch, so a WRITE, WRSR, ERAL or SETAL will be ignored until the next WREN.  (The latch is also
+//cleared by the device at the end of every write cycle, this is only needed to cancel a WREN that wasn't followed by a write).
+//Returns:
+//	1 is sucessful, 0 if the device didn't respond
+BYTE unio_eeprom_write_disable (void)
+{
+	if (!unio_eeprom_command(0b10010001, 0, 0, 0))		//WRDI command
+	{
+		unio_standby_pulse();
+		return(0);
+	}
+	return(1);
+}
+
+
+
+//************************************************
+//************************************************
+//********** EEPROM WRITE CYCLE COMMAND **********
+//************************************************
+//************************************************
+//WREN followed by a command that starts a write cycle (WRSR, ERAL or SETAL), then WIP polling.  Up to 3 attempts.
+//Returns:
+//	1 is sucessful, 0 if failed
+BYTE unio_eeprom_write_cycle_command (uint8_t command, uint8_t *data, uint8_t length)
+{
+	uint8_t retry_count = 3;
+
+	while (retry_count--)
+	{
+		if (retry_count < 2)
+			unio_stats.write_retries++;			//(Not the first attempt)
+
+		if ((unio_eeprom_command(command, 1, data, length)) && (unio_wait_for_write_complete()))
+			return(1);
+
+		unio_speed_feedback(0);
+		unio_standby_pulse();
+	}
+	return(0);
+}
+
+
+
+//************************************
+//************************************
+//********** EEPROM COMMAND **********
+//************************************
+//************************************
+//A short transaction with no address: optional WREN, then header, device address, command and length data bytes (NoMAK on the
+//last frame).  If the command starts a write cycle unio_write_start_ticks is set for unio_wait_for_write_complete().
+//Returns:
+//	1 if all SAKs received, 0 if there was a comms error (call unio_standby_pulse() before trying again)
+BYTE unio_eeprom_command (uint8_t command, uint8_t write_enable, uint8_t *data, uint8_t length)
+{
+#ifdef UNIO_USE_IRQ_ENGINE
+	UNIO_TRANSACTION transaction;
+
+	//----- ENABLE WRITES -----
+	if (write_enable)
+	{
+		unio_irq_load_transaction(&transaction, 0b10010110, 0, 0);		//WREN command
+		if (!unio_irq_run(&transaction))
+			return(0);
+	}
+
+	//----- COMMAND -----
+	unio_irq_load_transaction(&transaction, command, 0, 0);
+	transaction.tx_data = data;
+	transaction.tx_length = length;
+	if (!unio_irq_run(&transaction))
+		return(0);
+	unio_write_start_ticks = unio_bus_ticks;
+	return(1);
+#else
+	uint8_t count;
+
+	unio_comms_error = 0;
+	unio_timer_acquire();
+	DISABLE_INT;
+	unio_stats_int_off_begin();
+
+	//----- ENABLE WRITES -----
+	if (write_enable)
+		unio_write_enable();
+
+	//----- HEADER -----
+	if (!unio_comms_error)
+	{
+		unio_delay_5us(2);						//Observe Tss time (min 10uS, no max)
+		unio_start_header();
+	}
+
+	//----- DEVICE ADDRESS -----
+	unio_output_byte_checked(UNIO_EEPROM_ADDRESS);
+
+	//----- COMMAND -----
+	if (length)
+		unio_send_mak = 1;
+	else
+		unio_send_mak = 0;						//NoMAK ends the command
+	unio_output_byte_checked(command);
+
+	//----- DATA BYTES -----
+	for (count = 0; (count < length) && (!unio_comms_error); count++)
+	{
+		if (count < (length - 1))
+			unio_send_mak = 1;
+		else
+			unio_send_mak = 0;
+		unio_output_byte_checked(data[count]);
+	}
+
+	unio_idle();
+	unio_stats_int_off_end();
+	ENABLE_INT;
+	unio_timer_release();
+
+	if (unio_comms_error)
+		return(0);
+	unio_write_start_ticks = unio_bus_ticks;
+	return(1);
+#endif
+}
+
+
+
+//************************************
+//************************************
+//********** EEPROM COMPARE **********
+//************************************
+//************************************
+//Compares the device contents with data in a sequential read that stops at the first byte that differs (no buffer needed).  A comms
+//error part way through is retried from the first byte not yet compared.
+//Returns:
+//	Offset of the first byte that differs, length if all are the same, or UNIO_COMPARE_FAILED if the device couldn't be read or the
+//	range is past the end of the device
+uint16_t unio_eeprom_compare (uint16_t address, uint8_t *data, uint16_t length)
+{
+	uint16_t offset = 0;
+	uint16_t same_length;
+	uint8_t retry_count = 3;
+
+
+	if (((uint32_t)address + length) > UNIO_EEPROM_SIZE)
+		return(UNIO_COMPARE_FAILED);
+
+	unio_stats.reads++;
+	while ((offset < length) && (retry_count))
+	{
+		same_length = unio_eeprom_verify((address + offset), &data[offset], (length - offset));
+		offset += same_length;
+		if (!unio_comms_error)
+		{
+			unio_speed_feedback(1);
+			return(offset);						//First byte that differs, or length
+		}
+
+		//There was a read error, try again from the first byte not compared
+		unio_speed_feedback(0);
+		if (same_length)
+			retry_count = 3;					//(Progress was made, so 3 more tries for the rest)
+		else
+			retry_count--;
+		if (retry_count)
+			unio_stats.read_retries++;
+	}
+	if (offset >= length)
+		return(length);
+
+	//----- FAILED -----
+	unio_stats.failures++;
+	return(UNIO_COMPARE_FAILED);
+}
+
+
+
+//***********************************
+//***********************************
+//********** EEPROM VERIFY **********
+//***********************************
+//***********************************
+//Single attempt at comparing the device contents with data in a sequential read (no buffer needed).  The read is ended with a NoMAK
+//at the first byte that differs.  (Split into several reads if unio_int_off_budget_us is set.)
+//Returns:
+//	Offset of the first byte that didn't match, or length if all matched.  If a comms error stopped the compare unio_comms_error is
+//	set and the offset is the first byte not compared.
+uint16_t unio_eeprom_verify (uint16_t address, uint8_t *data, uint16_t length)
+{
+#ifdef UNIO_USE_IRQ_ENGINE
+	UNIO_TRANSACTION transaction;
+
+	unio_irq_load_transaction(&transaction, 0b00000011, 1, address);		//READ command
+	transaction.compare_data = data;
+	transaction.rx_length = length;
+	unio_comms_error = 0;
+	if (!unio_irq_run(&transaction))			//(The engine sends the standby pulse itself before the next transaction)
+		unio_comms_error = 1;
+	return(transaction.rx_done);
+#else
+	uint16_t offset = 0;
+	uint16_t chunk_length;
+	uint16_t same_length;
+
+	//Split into several READ transactions if unio_int_off_budget_us is set
+	while (1)
+	{
+		chunk_length = unio_int_off_max_bytes(5);
+		if (chunk_length > (length - offset))
+			chunk_length = length - offset;
+
+		same_length = unio_eeprom_verify_once((address + offset), &data[offset], chunk_length);
+		offset += same_length;
+		if ((unio_comms_error) || (same_length < chunk_length) || (offset >= length))
+			return(offset);
+	}
+#endif
+}
+
+
+//A single READ transaction for unio_eeprom_verify() with the bit banged driver.
+uint16_t unio_eeprom_verify_once (uint16_t address, uint8_t *data, uint16_t length)
+{
+	uint16_t count;
+	uint16_t bad_offset = length;
+	uint8_t different;
+
+	unio_comms_error = 0;
+
+	unio_timer_acquire();
+	DISABLE_INT;
+	unio_stats_int_off_begin();
+	unio_delay_5us(2);						//Observe Tss time (min 10uS, no max)
+
+	//----- HEADER -----
+	unio_start_header();
+
+	//----- DEVICE ADDRESS -----
+	unio_output_byte_checked(UNIO_EEPROM_ADDRESS);
+
+	//----- COMMAND -----
+	unio_output_byte_checked(0b00000011);		//READ command
+
+	//----- START ADDRESS H -----
+	unio_output_byte_checked((uint8_t)((address & 0xff00) >> 8));
+
+	//----- START ADDRESS L -----
+	unio_output_byte_checked((uint8_t)(address & 0x00ff));
+
+	if (unio_comms_error)
+		bad_offset = 0;
+
+	//----- DATA BYTES -----
+	unio_read_error = 0;
+	for (count = 0; (count < length) && (bad_offset == length); count++)
+	{
+		unio_input_byte();
+		different = (unio_data_in != data[count]) ? 1 : 0;		//(Before the SAK overwrites unio_data_in bit 0)
+		if ((count < (length - 1)) && (!unio_read_error) && (!different))
+			unio_send_mak = 1;
+		else
+			unio_send_mak = 0;				//(NoMAK ends the read at the first byte that didn't match or decode)
+		unio_ack_sequence();
+		if ((!unio_input_bit_read) || (unio_read_error))
+		{
+			unio_comms_error = 1;
+			bad_offset = count;
+		}
+		else if (different)
+		{
+			bad_offset = count;
+		}
+	}
+
+	unio_idle();
+	unio_stats_int_off_end();
+	ENABLE_INT;
+	unio_timer_release();
+
+	if ((unio_comms_error) && (!unio_read_error))
+		unio_standby_pulse();				//Missing SAK - the device needs a standby pulse before it will respond again
+	return(bad_offset);
+}
+
+
+
+//*************************************
+//*************************************
+//********** DEFERRED VERIFY **********
+//*************************************
+//*************************************
+//With unio_verify_policy = UNIO_VERIFY_DEFERRED unio_eeprom_write() stores the address, length and a checksum of each write instead of
+//reading it back.  unio_eeprom_verify_deferred() then reads the stored writes back in address order, with writes that are close together
+//(within UNIO_VERIFY_DEFERRED_MAX_GAP bytes) checked in a single sequential read, so a run of page writes costs one READ header instead of
+//one per page and no copy of the data needs to be kept.
+//Returns:
+//	1 if all writes since the last call verified, 0 if not (failed_address, optional, is loaded with the start address of the first write
+//	that didn't verify)
+BYTE unio_eeprom_verify_deferred (uint16_t *failed_address)
+{
+	BYTE success;
+
+	unio_verify_deferred_check();
+
+	success = unio_verify_deferred_failed ? 0 : 1;
+	if ((!success) && (failed_address))
+		*failed_address = unio_verify_failed_address;
+	unio_verify_deferred_failed = 0;
+	return(success);
+}
+
+
+//Store a write for a deferred verify.  Stored writes are verified first if the list is full or the new write overlaps one of them (its
+//checksum would no longer match).
+void unio_verify_deferred_add (uint16_t address, uint8_t *data, uint8_t length)
+{
+	uint8_t index;
+	UNIO_VERIFY_RECORD *record;
+
+	for (index = 0; index < unio_verify_record_count; index++)
+	{
+		record = &unio_verify_records[index];
+		if ((address < (record->address + record->length)) && ((address + length) > record->address))
+			break;
+	}
+	if ((index < unio_verify_record_count) || (unio_verify_record_count >= UNIO_VERIFY_DEFERRED_MAX))
+		unio_verify_deferred_check();
+
+	record = &unio_verify_records[unio_verify_record_count++];
+	record->address = address;
+	record->length = length;
+	record->checksum = unio_verify_checksum(data, length);
+}
+
+
+//Verify all stored writes and clear the list.  Failures are held in unio_verify_deferred_failed until unio_eeprom_verify_deferred().
+void unio_verify_deferred_check (void)
+{
+	UNIO_VERIFY_RECORD record;
+	uint8_t index;
+	uint8_t first;
+	uint8_t retry_count;
+
+	//----- SORT INTO ADDRESS ORDER -----
+	for (index = 1; index < unio_verify_record_count; index++)
+	{
+		record = unio_verify_records[index];
+		for (first = index; (first) && (unio_verify_records[first - 1].address > record.address); first--)
+			unio_verify_records[first] = unio_verify_records[first - 1];
+		unio_verify_records[first] = record;
+	}
+
+	//----- READ BACK EACH RUN OF WRITES THAT ARE CLOSE TOGETHER -----
+	first = 0;
+	for (index = 1; index <= unio_verify_record_count; index++)
+	{
+		if ((index < unio_verify_record_count) &&
+			(unio_verify_records[index].address <= (unio_verify_records[index - 1].address + unio_verify_records[index - 1].length + UNIO_VERIFY_DEFERRED_MAX_GAP)) &&
+			((unio_verify_records[index].address + unio_verify_records[index].length - unio_verify_records[first].address) <= unio_int_off_max_bytes(5)))
+			continue;						//(A run is also ended before it would go over unio_int_off_budget_us)
+
+		for (retry_count = 3; retry_count; retry_count--)
+		{
+			if ((unio_verify_deferred_run(first, (index - 1))) || (!unio_comms_error))
+				break;						//Verified, or read ok but a checksum didn't match
+			unio_standby_pulse();
+		}
+		if (!retry_count)
+		{
+			//Couldn't be read back - treat as failed
+			if (!unio_verify_deferred_failed)
+				unio_verify_failed_address = unio_verify_records[first].address;
+			unio_verify_deferred_failed = 1;
+		}
+		first = index;
+	}
+	unio_verify_record_count = 0;
+}
+
+
+//Read back stored writes first to last (in address order, with no overlaps) in a single READ transaction and compare their checksums.
+//Returns:
+//	1 if all matched, 0 if not (unio_comms_error is set if it was a comms error rather than a checksum mismatch)
+BYTE unio_verify_deferred_run (uint8_t first, uint8_t last)
+{
+	UNIO_VERIFY_RECORD *record = &unio_verify_records[first];
+	UNIO_VERIFY_RECORD *failed_record = 0;
+#ifndef UNIO_USE_IRQ_ENGINE
+	uint16_t address = record->address;
+	uint16_t length = unio_verify_records[last].address + unio_verify_records[last].length - address;
+	uint16_t record_start = record->address;
+	uint16_t record_end = record->address + record->length - 1;
+	uint16_t count;
+	uint8_t sum1 = 0;
+	uint8_t sum2 = 0;
+#endif
+
+	unio_comms_error = 0;
+
+#ifdef UNIO_USE_IRQ_ENGINE
+	//Read each write into unio_temp_data_buffer (the engine needs a buffer for the bytes read)
+	for (; first <= last; first++, record++)
+	{
+		if (!unio_eeprom_read_device(record->address, &unio_temp_data_buffer[0], record->length))
+		{
+			unio_comms_error = 1;
+			return(0);
+		}
+		if (unio_verify_checksum(&unio_temp_data_buffer[0], record->length) != record->checksum)
+		{
+			failed_record = record;
+			break;
+		}
+	}
+#else
+	unio_timer_acquire();
+	DISABLE_INT;
+	unio_stats_int_off_begin();
+	unio_delay_5us(2);						//Observe Tss time (min 10uS, no max)
+
+	//----- HEADER -----
+	unio_start_header();
+
+	//----- DEVICE ADDRESS -----
+	unio_output_byte_checked(UNIO_EEPROM_ADDRESS);
+
+	//----- COMMAND -----
+	unio_output_byte_checked(0b00000011);		//READ command
+
+	//----- START ADDRESS H -----
+	unio_output_byte_checked((uint8_t)((address & 0xff00) >> 8));
+
+	//----- START ADDRESS L -----
+	unio_output_byte_checked((uint8_t)(address & 0x00ff));
+
+	//----- DATA BYTES -----
+	unio_read_error = 0;
+	for (count = 0; (count < length) && (!unio_comms_error) && (!unio_read_error); count++)
+	{
+		unio_input_byte();
+		if ((address + count) >= record_start)
+		{
+			//Fletcher-16 (kept short as it is done between the last data bit and the MAK)
+			sum1 += unio_data_in;
+			sum2 += sum1;
+			if ((address + count) == record_end)
+			{
+				if (((((uint16_t)sum2) << 8) | sum1) != record->checksum)
+				{
+					if (!failed_record)
+						failed_record = record;
+				}
+				sum1 = 0;
+				sum2 = 0;
+				if (record < &unio_verify_records[last])
+				{
+					record++;
+					record_start = record->address;
+					record_end = record->address + record->length - 1;
+				}
+			}
+		}
+		if ((count < (length - 1)) && (!unio_read_error))
+			unio_send_mak = 1;
+		else
+			unio_send_mak = 0;
+		unio_ack_sequence();
+		if (!unio_input_bit_read)				//Got SAK?
+			unio_comms_error = 1;
+	}
+	if (unio_read_error)
+		unio_comms_error = 1;
+
+	unio_idle();
+	unio_stats_int_off_end();
+	ENABLE_INT;
+	unio_timer_release();
+
+	if (unio_comms_error)
+		return(0);
+#endif
+
+	if (failed_record)
+	{
+		unio_stats.verify_errors++;
+		if (!unio_verify_deferred_failed)
+			unio_verify_failed_address = failed_record->address;
+		unio_verify_deferred_failed = 1;
+		return(0);
+	}
+	return(1);
+}
+
+
+//Fletcher-16 with modulo 256 sums (2 additions per byte)
+uint16_t unio_verify_checksum (uint8_t *data, uint8_t length)
+{
+	uint8_t sum1 = 0;
+	uint8_t sum2 = 0;
+
+	while (length--)
+	{
+		sum1 += *data++;
+		sum2 += sum1;
+	}
+	return((((uint16_t)sum2) << 8) | sum1);
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+//**********************************
+//**********************************
+//********** WRITE ENABLE **********
+//**********************************
+//**********************************
+//Set the WEL bit in the Status Register.
+void unio_write_enable (void)
+{
+	unio_delay_5us(2);						//Observe Tss time (min 10uS, no max)
+
+	//----- HEADER -----
+    unio_start_header();
+
+	//----- DEVICE ADDRESS -----
+	unio_output_byte_checked(UNIO_EEPROM_ADDRESS);
+
+	//----- COMMAND -----
+	unio_send_mak = 0;
+	unio_output_byte_checked(0b10010110);		//WREN command
+
+    unio_idle();
+}
+
+
+//**********************************
+//**********************************
+//********** START HEADER **********
+//**********************************
+//**********************************
 //Hold SCIO low for Thdr time period (min 5uS) and output Start Header ('01010101').
 //Takes 5 us (including call to OutputByte)
 void unio_start_header (void)
 {
+	uint32_t sak_errors;
+
 	UNIO_SCIO_OUTPUT(0);
 	UNIO_SCIO_TRIS(0);
 
 	UNIO_EEPROM_CLEAR_IRQ_FLAG();		//Force min 5uS Thdr time period
+	unio_bus_ticks += unio_quarters_per_5us;
 
 	unio_data_out = 0x55;				//Load Start Header value
 
 	unio_send_mak = 1;
 	
-	while (!UNIO_EEPROM_READ_IRQ_FLAG())
-		;
-	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	for (unio_count = unio_quarters_per_5us; unio_count; unio_count--)
+	{
+		while (!UNIO_EEPROM_READ_IRQ_FLAG())
+			;
+		UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	}
 
+	sak_errors = unio_stats.sak_errors;
 	unio_output_byte();
+	unio_stats.sak_errors = sak_errors;		//(Not counted as a missing SAK)
 	//if (!unio_input_bit_read)				//Got SAK? (no SAK sent after header as device not addressed yet)
 	//	unio_comms_error = 1;
 }
@@ -430,6 +1929,7 @@ void unio_start_header (void)
 void unio_output_byte(void)
 {
 	UNIO_SCIO_TRIS(0);					//Ensure SCIO is outputting
+	unio_bus_ticks += 32;
 
 	unio_count = 8;
     while (unio_count--)
@@ -469,6 +1969,20 @@ void unio_output_byte(void)
     unio_ack_sequence();                 // Perform Acknowledge Sequence
 }
 
+
+//Output a byte and check for its SAK.  Nothing is output once unio_comms_error is set, so a transaction stops at its first missing SAK
+//rather than clocking out the rest of its bytes.
+void unio_output_byte_checked (uint8_t value)
+{
+	if (unio_comms_error)
+		return;
+
+	unio_data_out = value;
+	unio_output_byte();
+	if (!unio_input_bit_read)				//Got SAK?
+		unio_comms_error = 1;
+}
+
 //**************************************************
 //**************************************************
 //********** PERFORM ACKNOWLEDGE SEQUENCE **********
@@ -478,6 +1992,7 @@ void unio_output_byte(void)
 void unio_ack_sequence(void)
 {
 	UNIO_SCIO_TRIS(0);					//Ensure SCIO is outputting
+	unio_bus_ticks += 8;
 
 	//-------------------------------
 	//----- DO MAK (Master ACK) -----
@@ -519,9 +2034,148 @@ void unio_ack_sequence(void)
 	//------------------------------
 	UNIO_SCIO_TRIS(1);				//Set SCIO to be an input
 
-	//Input SAK bit
-	unio_input_bit();
+	//Input SAK bit
+	unio_input_bit();
+	if (!unio_input_bit_read)
+		unio_stats.sak_errors++;
+}
+
+
+
+
+#ifdef UNIO_USE_ENCODED_FRAMES
+//**********************************
+//**********************************
+//********** ENCODE BEGIN **********
+//**********************************
+//**********************************
+//Start a new encoded transaction in unio_encoded_frames[] with the start header ('01010101' + MAK, no SAK as no device is addressed yet).
+//Encode the transaction before disabling interrupts, unio_encoded_play() then only has to copy levels to SCIO.
+void unio_encode_begin (void)
+{
+	unio_encoded_frame_count = 0;
+	unio_encode_byte(0x55, 1);
+	unio_encoded_frames[0] &= ~UNIO_ENCODED_CHECK_SAK;
+}
+
+
+
+//*********************************
+//*********************************
+//********** ENCODE BYTE **********
+//*********************************
+//*********************************
+//Manchester-encode a byte and its MAK/NoMAK into the next frame of unio_encoded_frames[] as 18 half bit SCIO levels (bit 17 first).
+//Returns:
+//	1 if added, 0 if the buffer is full
+BYTE unio_encode_byte (uint8_t value, uint8_t send_mak)
+{
+	uint32_t levels;
+	uint8_t count;
+
+	if (unio_encoded_frame_count >= UNIO_ENCODED_MAX_FRAMES)
+		return(0);
+
+	levels = 0;
+	for (count = 0; count < 8; count++)
+	{
+		if (value & 0x80)
+			levels = (levels << 2) | 0x01;		//1 = low then high
+		else
+			levels = (levels << 2) | 0x02;		//0 = high then low
+		value <<= 1;
+	}
+	if (send_mak)
+		levels = (levels << 2) | 0x01;
+	else
+		levels = (levels << 2) | 0x02;
+
+	unio_encoded_frames[unio_encoded_frame_count++] = levels | UNIO_ENCODED_CHECK_SAK;
+	return(1);
+}
+
+
+
+//*****************************************
+//*****************************************
+//********** PLAY ENCODED FRAMES **********
+//*****************************************
+//*****************************************
+//Outputs Thdr and the frames in unio_encoded_frames[].  Each half bit is a single shift and port write with no decisions or function
+//calls in the bit timing, SAKs are sampled inline and only checked after the last frame.  Call with interrupts disabled after Tss.
+//Bus state on return is the same as after unio_output_byte() for the last frame.
+//Returns:
+//	1 if all SAKs received, 0 if there was a comms error
+BYTE unio_encoded_play (void)
+{
+	uint32_t *frame;
+	uint32_t levels;
+	uint8_t frames;
+	uint8_t half;
+	uint8_t sak;
+	uint8_t check_sak;
+	uint8_t sak_error = 0;
+
+	//----- HEADER LOW -----
+	UNIO_SCIO_OUTPUT(0);
+	UNIO_SCIO_TRIS(0);
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();		//Force min 5uS Thdr time period
+	unio_bus_ticks += unio_quarters_per_5us;
+	for (half = unio_quarters_per_5us; half; half--)
+	{
+		while (!UNIO_EEPROM_READ_IRQ_FLAG())
+			;
+		UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	}
+
+	frame = &unio_encoded_frames[0];
+	for (frames = unio_encoded_frame_count; frames; frames--)
+	{
+		levels = *frame++;
+		check_sak = (levels & UNIO_ENCODED_CHECK_SAK) ? 0xff : 0x00;
+		UNIO_SCIO_TRIS(0);					//Ensure SCIO is outputting
+		unio_bus_ticks += 40;
+
+		//----- 8 DATA BITS + MAK -----
+		for (half = 18; half; half--)
+		{
+			while (!UNIO_EEPROM_READ_IRQ_FLAG())
+				;
+			UNIO_SCIO_OUTPUT((levels >> 17) & 0x01);
+			levels <<= 1;
+			UNIO_EEPROM_CLEAR_IRQ_FLAG();
+			while (!UNIO_EEPROM_READ_IRQ_FLAG())
+				;
+			UNIO_EEPROM_CLEAR_IRQ_FLAG();
+		}
+		while (!UNIO_EEPROM_READ_IRQ_FLAG())
+			;
+
+		//----- SAK -----
+		UNIO_SCIO_TRIS(1);				//Set SCIO to be an input
+		UNIO_EEPROM_CLEAR_IRQ_FLAG();
+		while (!UNIO_EEPROM_READ_IRQ_FLAG())
+			;
+		sak = UNIO_SCIO_INPUT ? 0x02 : 0x00;		//1/4 into bit period
+		UNIO_EEPROM_CLEAR_IRQ_FLAG();
+		while (!UNIO_EEPROM_READ_IRQ_FLAG())
+			;
+		UNIO_EEPROM_CLEAR_IRQ_FLAG();
+		while (!UNIO_EEPROM_READ_IRQ_FLAG())
+			;
+		sak |= UNIO_SCIO_INPUT ? 0x01 : 0x00;		//3/4 into bit period
+		UNIO_EEPROM_CLEAR_IRQ_FLAG();
+
+		if ((sak ^ 0x01) & check_sak)		//SAK is a 1 bit (low then high)
+		{
+			sak_error = 1;
+			unio_stats.sak_errors++;
+			break;							//Stop at the first missing SAK
+		}
+	}
+	return(sak_error ? 0 : 1);
 }
+#endif
 
 
 
@@ -534,7 +2188,14 @@ void unio_ack_sequence(void)
 //Inputs and Manchester-decodes from SCIO a byte of data and stores it in unio_data_in.
 void unio_input_byte (void)
 {
+	uint8_t read_error = unio_read_error;
+
+	unio_read_error = 0;
+#ifdef UNIO_USE_EDGE_DECODER
+	unio_input_byte_edges();
+#else
 	UNIO_SCIO_TRIS(1);				//Set SCIO to be an input
+	unio_bus_ticks += 32;
 	//Loop through byte
 	for (unio_count = 0; unio_count < 8; unio_count++)
 	{
@@ -543,7 +2204,113 @@ void unio_input_byte (void)
 		unio_data_in <<= 1;
 		unio_input_bit();
 	}
+#endif
+	if (unio_read_error)
+		unio_stats.decode_errors++;
+	unio_read_error |= read_error;
+}
+
+
+
+#ifdef UNIO_USE_EDGE_DECODER
+//*******************************************
+//*******************************************
+//********** INPUT BYTE FROM EDGES **********
+//*******************************************
+//*******************************************
+//Inputs and Manchester-decodes a byte from the times of the SCIO edges captured over its 32 quarter bit periods, instead of sampling
+//each bit at its 1/4 and 3/4 points.  Each mid bit edge is looked for around where the previous one predicts it, so the device's
+//clock error is tracked across the byte and a bit is only lost once it has drifted by almost half a bit period (a quarter bit period
+//with fixed sampling).  The bit value is the SCIO level at the first quarter tick after its mid bit edge.
+//Returns:
+//	unio_read_error			Set if a mid bit edge was missing
+//	unio_data_in			Byte read
+void unio_input_byte_edges (void)
+{
+	uint32_t levels = 0;			//SCIO level at the end of each quarter bit period, bit n = end of quarter n
+	uint32_t expected_mid;
+	uint32_t mid;
+	uint16_t capture;
+	uint8_t quarter;
+	uint8_t sample_quarter;
+	uint8_t edge;
+	uint8_t next_edge = 0;
+	uint8_t bit = 0;
+
+	UNIO_SCIO_TRIS(1);				//Set SCIO to be an input
+	unio_bus_ticks += 32;
+	unio_edge_count = 0;
+	expected_mid = (uint32_t)unio_quarter_period * 2;
+
+	while (!UNIO_EEPROM_READ_IRQ_FLAG())
+		;
+	//We are now at start of first bit
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	while (UNIO_SCIO_CAPTURE_READ() != UNIO_SCIO_NO_CAPTURE)		//Discard the SAK edges
+		;
+
+	for (quarter = 0; quarter < 32; quarter++)
+	{
+		while (!UNIO_EEPROM_READ_IRQ_FLAG())
+			;
+		if (UNIO_SCIO_INPUT)
+			levels |= (uint32_t)0x01 << quarter;
+		if (quarter < 31)
+			UNIO_EEPROM_CLEAR_IRQ_FLAG();		//(Left set at the end of the byte for unio_ack_sequence())
+
+		while ((capture = UNIO_SCIO_CAPTURE_READ()) != UNIO_SCIO_NO_CAPTURE)
+		{
+			if (unio_edge_count < UNIO_EDGE_MAX_EDGES)
+				unio_edge_times[unio_edge_count++] = ((uint32_t)quarter * unio_quarter_period) + capture;
+		}
+
+		//----- DECODE EACH BIT ONCE ITS MID BIT EDGE AND THE SAMPLE AFTER IT HAVE BEEN SEEN -----
+		while (bit < 8)
+		{
+			//Mid bit edge must be within 1 quarter bit period of where it is expected (bit boundary edges are 2 away)
+			for (edge = next_edge; edge < unio_edge_count; edge++)
+			{
+				if ((unio_edge_times[edge] + unio_quarter_period) > expected_mid)
+					break;
+			}
+			if ((edge >= unio_edge_count) || (unio_edge_times[edge] >= (expected_mid + unio_quarter_period)))
+			{
+				if (((uint32_t)(quarter + 1) * unio_quarter_period) < (expected_mid + unio_quarter_period))
+					break;							//Not reached yet
+
+				//No mid bit edge
+				unio_read_error = 1;
+				unio_data_in <<= 1;
+				expected_mid += (uint32_t)unio_quarter_period * 4;
+				next_edge = edge;
+				bit++;
+				continue;
+			}
+			mid = unio_edge_times[edge];
+
+			sample_quarter = (uint8_t)((mid + UNIO_EDGE_MARGIN + unio_quarter_period - 1) / unio_quarter_period) - 1;
+			if (sample_quarter > quarter)
+				break;								//Sample after the edge not taken yet
+
+			unio_data_in <<= 1;
+			if (levels & ((uint32_t)0x01 << sample_quarter))
+				unio_data_in |= 0x01;				//Low to high = 1
+
+			expected_mid = mid + ((uint32_t)unio_quarter_period * 4);
+			next_edge = edge + 1;
+			bit++;
+		}
+	}
+
+	//----- LAST BIT(S) DRIFTED PAST THE END OF THE BYTE -----
+	while (bit < 8)
+	{
+		unio_read_error = 1;
+		unio_data_in <<= 1;
+		bit++;
+	}
 }
+#endif
 
 
 //*******************************
@@ -617,6 +2384,7 @@ void unio_input_bit (void)
 //Waits until end of current bit period has been reached, ensures SCIO is high for bus idle
 void unio_idle (void)
 {
+	unio_bus_ticks++;
 	while (!UNIO_EEPROM_READ_IRQ_FLAG())
 		;
 	UNIO_EEPROM_CLEAR_IRQ_FLAG();
@@ -633,6 +2401,9 @@ void unio_idle (void)
 //Wait Tstby with line high between communicating with one device and a new device (not requried if communicating with same device)
 void unio_standby_pulse (void)
 {
+	unio_stats.standby_pulses++;
+	unio_timer_acquire();
+	unio_bus_ticks++;
 	while (!UNIO_EEPROM_READ_IRQ_FLAG())
 		;
 	UNIO_EEPROM_CLEAR_IRQ_FLAG();
@@ -641,6 +2412,7 @@ void unio_standby_pulse (void)
 	UNIO_SCIO_TRIS(0);					//Ensure SCIO is outputting
 
 	unio_delay_5us(120);				//Tstby min 600uS, no max
+	unio_timer_release();
 }
 
 
@@ -650,77 +2422,538 @@ void unio_standby_pulse (void)
 //********** WAIT FOR WRITE COMPLETE **********
 //*********************************************
 //*********************************************
-//This function performs WIP polling to determine the end of the current write cycle. It does this by continuously
-//executing a Read Status Register operation until the WIP bit (bit 0 of the Status Register) is read low.
-void unio_wait_for_write_complete (void)
+//This function performs WIP polling to determine the end of the write cycle started by unio_eeprom_write_start().  Each poll is a
+//separate short Read Status Register transaction, so interrupts are enabled between polls rather than held off for the whole write cycle.
+//The write cycle time is learnt for each temperature band (unio_write_cycle_band), as the time from the end of the WRITE transaction to
+//the start of the first poll that sees it complete.  Once known we wait without using the bus until just after that time, so normally a
+//single poll is needed:
+//- If that poll sees WIP still set, the write took longer and the start time of the last busy poll becomes the new learnt time.
+//- If it sees the write complete, the learnt time is reduced slightly so it tracks a part that is getting faster.
+//The wait is still a busy-wait - unio_delay_quarters() counts timer roll overs and doesn't return until the time has passed, so the
+//learnt time saves bus transactions and interrupt disabled periods but not CPU time.  To do other work during the write cycle use
+//unio_eeprom_write_start() and unio_eeprom_is_write_complete() instead.
+//The time since the write started is counted in unio_bus_ticks, which only advance while the driver is clocking the bus, so this must
+//be called straight after the write is started (as unio_eeprom_write_page() and unio_eeprom_write_cycle_command() do).  Time the
+//application spends between unio_eeprom_write_start() and a later wait isn't seen - poll unio_eeprom_is_write_complete() instead.
+//Returns:
+//	1 once the WIP bit (bit 0 of the Status Register) is read low, 0 if it never was (unio_comms_error is also set)
+BYTE unio_wait_for_write_complete (void)
 {
-	uint16_t count;
-	uint8_t retry_count = 3;
-	uint8_t error_occured;
-
-	while (retry_count--)
+	uint8_t count;
+	uint8_t band;
+	uint32_t learnt;
+	uint32_t elapsed;
+	uint32_t busy_elapsed = 0;
+	uint32_t max_elapsed;
+
+	band = unio_write_cycle_band;
+	if (band >= UNIO_WRITE_CYCLE_BANDS)
+		band = UNIO_WRITE_CYCLE_BANDS - 1;
+	learnt = unio_write_cycle_ticks[band];
+
+	//----- WAIT UNTIL JUST AFTER THE EXPECTED FINISH -----
+	if (learnt)
 	{
-		unio_delay_5us(2);						//Observe Tss time (min 10uS, no max)
-
-		//----- HEADER -----
-		unio_send_mak = 1;
-		unio_start_header();					//Output Start Header
+		learnt += (learnt >> 4);					//Margin of 1/16th
+		elapsed = unio_bus_ticks - unio_write_start_ticks;
+		if (learnt > (elapsed + 1))
+			unio_delay_quarters(learnt - elapsed - 1);		//(Delays for the value + 1 quarter bit periods)
+	}
 
-		//----- DEVICE ADDRESS -----
-		unio_data_out = UNIO_EEPROM_ADDRESS;
-		unio_output_byte();
-		if (!unio_input_bit_read)				//Got SAK?
+	//----- POLL -----
+	max_elapsed = UNIO_EEPROM_US_TO_TICKS(UNIO_EEPROM_WRITE_CYCLE_US * 2);		//Give up after twice the max write cycle time
+	for (count = 0; count < 255; count++)
+	{
+		elapsed = unio_bus_ticks - unio_write_start_ticks;
+		if (elapsed > max_elapsed)
+			break;
+		unio_stats.wip_polls++;
+		if (unio_eeprom_is_write_complete())
 		{
-			unio_standby_pulse();
-			continue;
+			//----- LEARN THE WRITE CYCLE TIME -----
+			learnt = unio_write_cycle_ticks[band];
+			if (busy_elapsed)
+				learnt = busy_elapsed;				//Took longer than expected - it took at least this long
+			else if (learnt)
+				learnt -= (learnt >> 5);			//Complete at the first poll - try a little earlier next time
+			else
+				learnt = elapsed;					//First write
+			if (learnt > 0xffff)
+				learnt = 0xffff;
+			unio_write_cycle_ticks[band] = (uint16_t)learnt;
+			return(1);
 		}
+		busy_elapsed = elapsed;
+	}
+	unio_stats.wip_timeouts++;
+	unio_comms_error = 1;
+	return(0);
+}
 
-		unio_data_out = 0b00000101;				//RDSR command
-		unio_output_byte();
-		if (!unio_input_bit_read)				//Got SAK?
+
+
+
+
+
+
+
+
+
+
+#ifdef UNIO_USE_IRQ_ENGINE
+//**************************************************
+//**************************************************
+//********** SUBMIT INTERRUPT TRANSACTION **********
+//**************************************************
+//**************************************************
+//Queues a transaction to be carried out by the timer interrupt.  transaction must remain valid until its status is no longer UNIO_IRQ_BUSY.
+//Returns:
+//	1 if queued, 0 if transaction is already queued or in progress (it is left as it was)
+BYTE unio_irq_submit (UNIO_TRANSACTION *transaction)
+{
+	UNIO_TRANSACTION *queued;
+
+	UNIO_EEPROM_DISABLE_TIMER_IRQ();				//Protect the queue from the interrupt
+
+	for (queued = unio_irq_current; queued; queued = queued->next)
+	{
+		if (queued == transaction)
 		{
-			unio_standby_pulse();
-			continue;
+			//----- ALREADY QUEUED -----
+			UNIO_EEPROM_ENABLE_TIMER_IRQ();		//(The queue isn't empty)
+			return(0);
 		}
+	}
 
+	transaction->status = UNIO_IRQ_BUSY;
+	transaction->next = 0;
 
-		count = 0;
-		unio_read_error = 0;
-		unio_input_byte();						//Input byte
-		if (unio_read_error)
-			unio_data_in |= 0x01;
-		while ((unio_data_in & 0x01) && (count < 120))		//Max 10mS write, 10mS / 100uS(fastest possible read byte) = 50, add a bit for just in case
+	if (unio_irq_current)
+	{
+		//----- ADD TO QUEUE -----
+		unio_irq_last->next = transaction;
+		unio_irq_last = transaction;
+		UNIO_EEPROM_ENABLE_TIMER_IRQ();
+		return(1);
+	}
+
+	unio_irq_current = transaction;
+	unio_irq_last = transaction;
+
+	if (unio_timer_other_locked)
+	{
+		//----- TIMER LOCKED BY ITS OTHER USER - START WHEN IT IS UNLOCKED -----
+		if (unio_timer_other_isr)
+			UNIO_EEPROM_ENABLE_TIMER_IRQ();
+		return(1);
+	}
+
+	//----- START NOW -----
+	unio_timer_acquire();
+	unio_irq_start_transaction();
+
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	UNIO_EEPROM_ENABLE_TIMER_IRQ();
+	return(1);
+}
+
+
+//************************************************
+//************************************************
+//********** POLL INTERRUPT TRANSACTION **********
+//************************************************
+//************************************************
+UNIO_IRQ_STATUS unio_irq_poll (UNIO_TRANSACTION *transaction)
+{
+	return(transaction->status);
+}
+
+
+//***********************************************
+//***********************************************
+//********** RUN INTERRUPT TRANSACTION **********
+//***********************************************
+//***********************************************
+//Submit and wait for a transaction to complete (for the blocking functions when UNIO_USE_IRQ_ENGINE is defined)
+//Returns:
+//	1 is sucessful, 0 if failed
+BYTE unio_irq_run (UNIO_TRANSACTION *transaction)
+{
+	unio_irq_submit(transaction);
+	while (transaction->status == UNIO_IRQ_BUSY)
+		UNIO_EEPROM_IDLE_WAIT();
+
+	return(transaction->status == UNIO_IRQ_DONE);
+}
+
+
+//************************************************
+//************************************************
+//********** LOAD INTERRUPT TRANSACTION **********
+//************************************************
+//************************************************
+//Setup a transaction with no data bytes
+void unio_irq_load_transaction (UNIO_TRANSACTION *transaction, uint8_t command, uint8_t send_address, uint16_t address)
+{
+	transaction->command = command;
+	transaction->send_address = send_address;
+	transaction->address = address;
+	transaction->tx_data = 0;
+	transaction->tx_length = 0;
+	transaction->rx_data = 0;
+	transaction->rx_length = 0;
+	transaction->compare_data = 0;
+	transaction->callback = 0;
+}
+
+
+//*************************************************
+//*************************************************
+//********** START INTERRUPT TRANSACTION **********
+//*************************************************
+//*************************************************
+void unio_irq_start_transaction (void)
+{
+	UNIO_TRANSACTION *transaction = unio_irq_current;
+
+	unio_irq_header[0] = 0x55;						//Start header
+	unio_irq_header[1] = UNIO_EEPROM_ADDRESS;
+	unio_irq_header[2] = transaction->command;
+	unio_irq_header_length = 3;
+	if (transaction->send_address)
+	{
+		unio_irq_header[3] = (uint8_t)((transaction->address & 0xff00) >> 8);
+		unio_irq_header[4] = (uint8_t)(transaction->address & 0x00ff);
+		unio_irq_header_length = 5;
+	}
+	unio_irq_frames = unio_irq_header_length + transaction->tx_length + transaction->rx_length;
+	unio_irq_compare_different = 0;
+
+	UNIO_SCIO_OUTPUT(1);
+	UNIO_SCIO_TRIS(0);
+
+	unio_irq_state = UNIO_IRQ_STATE_SETUP;
+	if (unio_irq_need_standby)
+	{
+		unio_irq_quarter_count = (120 * unio_quarters_per_5us) + 1;	//Tstby min 600uS, no max (same as unio_standby_pulse)
+		unio_stats.standby_pulses++;
+	}
+	else
+		unio_irq_quarter_count = (2 * unio_quarters_per_5us) + 1;		//Observe Tss time (min 10uS, no max)
+	unio_irq_need_standby = 0;
+}
+
+
+//**********************************************
+//**********************************************
+//********** LOAD NEXT FRAME TO CLOCK **********
+//**********************************************
+//**********************************************
+void unio_irq_load_frame (void)
+{
+	UNIO_TRANSACTION *transaction = unio_irq_current;
+	uint16_t index = unio_irq_frame;
+
+	unio_irq_bit = 0;
+	unio_irq_quarter = 0;
+	unio_irq_frame_mak = (unio_irq_frame < (unio_irq_frames - 1)) ? 1 : 0;		//NoMAK on the last byte
+	unio_irq_frame_is_rx = 0;
+
+	if (index < unio_irq_header_length)
+	{
+		unio_irq_frame_byte = unio_irq_header[index];
+		return;
+	}
+	index -= unio_irq_header_length;
+
+	if (index < transaction->tx_length)
+	{
+		unio_irq_frame_byte = transaction->tx_data[index];
+		return;
+	}
+
+	unio_irq_frame_is_rx = 1;
+	unio_irq_frame_byte = 0;
+}
+
+
+//***********************************************
+//***********************************************
+//********** END INTERRUPT TRANSACTION **********
+//***********************************************
+//***********************************************
+void unio_irq_end_transaction (UNIO_IRQ_STATUS status)
+{
+	UNIO_TRANSACTION *transaction = unio_irq_current;
+
+	UNIO_SCIO_OUTPUT(1);							//Ensure SCIO is high for bus idle
+	UNIO_SCIO_TRIS(0);
+
+	if (status == UNIO_IRQ_FAILED)
+	{
+		unio_irq_need_standby = 1;					//Device needs a standby pulse before it will respond again
+
+		//Bytes received before the failure (each has had its SAK)
+		transaction->rx_done = 0;
+		if (unio_irq_frame > (unio_irq_header_length + transaction->tx_length))
+			transaction->rx_done = unio_irq_frame - unio_irq_header_length - transaction->tx_length;
+	}
+	else if (unio_irq_compare_different)
+	{
+		transaction->rx_done = unio_irq_frames - 1 - unio_irq_header_length - transaction->tx_length;		//(The byte that differed was the last frame)
+	}
+	else
+	{
+		transaction->rx_done = transaction->rx_length;
+	}
+
+	unio_irq_current = transaction->next;
+	if (unio_irq_current)
+	{
+		unio_irq_start_transaction();
+	}
+	else
+	{
+		unio_irq_state = UNIO_IRQ_STATE_IDLE;
+		UNIO_EEPROM_DISABLE_TIMER_IRQ();
+		unio_timer_release();						//(Re-enables the timer interrupt if the timer has another user)
+	}
+
+	transaction->status = status;
+	if (transaction->callback)
+		transaction->callback(transaction);
+}
+
+
+//******************************************
+//******************************************
+//********** TIMER INTERRUPT TICK **********
+//******************************************
+//******************************************
+//Call from the timer interrupt.  Each call is one quarter bit period - bits are output and sampled at the same points in the bit
+//period as the blocking functions.
+void unio_irq_tick (void)
+{
+	uint8_t bit_value;
+
+	UNIO_EEPROM_CLEAR_IRQ_FLAG();
+	unio_bus_ticks++;
+
+	switch (unio_irq_state)
+	{
+	case UNIO_IRQ_STATE_SETUP:
+		if (--unio_irq_quarter_count)
+			return;
+		UNIO_SCIO_OUTPUT(0);						//Hold SCIO low for Thdr
+		unio_irq_quarter_count = unio_quarters_per_5us + 1;
+		unio_irq_state = UNIO_IRQ_STATE_HEADER_LOW;
+		return;
+
+	case UNIO_IRQ_STATE_HEADER_LOW:
+		if (--unio_irq_quarter_count)
+			return;
+		unio_irq_frame = 0;
+		unio_irq_load_frame();
+		unio_irq_state = UNIO_IRQ_STATE_BITS;
+		break;										//Start the first bit now
+
+	case UNIO_IRQ_STATE_BITS:
+		break;
+
+	case UNIO_IRQ_STATE_END:
+		unio_irq_end_transaction(UNIO_IRQ_DONE);
+		return;
+
+	default:
+		UNIO_EEPROM_DISABLE_TIMER_IRQ();
+		return;
+	}
+
+	//----- CLOCK THE CURRENT BIT -----
+	if ((unio_irq_bit == 9) || ((unio_irq_bit < 8) && (unio_irq_frame_is_rx)))
+	{
+		//----- BIT DRIVEN BY THE SLAVE (DATA OR SAK) -----
+		if (unio_irq_quarter == 0)
+		{
+			UNIO_SCIO_TRIS(1);						//Set SCIO to be an input
+		}
+		else if (unio_irq_quarter == 1)
+		{
+			unio_irq_sample = UNIO_SCIO_INPUT ? 0x02 : 0x00;		//1/4 into bit period
+		}
+		else if (unio_irq_quarter == 3)
 		{
-			error_occured = 0;
+			if (UNIO_SCIO_INPUT)									//3/4 into bit period
+				unio_irq_sample |= 0x01;
 
-			unio_ack_sequence();
-			if (!unio_input_bit_read)				//Got SAK?
-				error_occured = 1;
+			if ((unio_irq_sample != 0x01) && (unio_irq_sample != 0x02))
+			{
+				//No mid bit edge - abort now (no SAK is expected after the start header)
+				if ((unio_irq_bit < 8) || (unio_irq_frame != 0))
+				{
+					if (unio_irq_bit < 8)
+						unio_stats.decode_errors++;
+					else
+						unio_stats.sak_errors++;
+					unio_irq_end_transaction(UNIO_IRQ_FAILED);
+					return;
+				}
+			}
+			else if (unio_irq_bit < 8)
+			{
+				unio_irq_frame_byte = (uint8_t)((unio_irq_frame_byte << 1) | (unio_irq_sample & 0x01));
+			}
+			else if ((unio_irq_sample != 0x01) && (unio_irq_frame != 0))
+			{
+				unio_stats.sak_errors++;
+				unio_irq_end_transaction(UNIO_IRQ_FAILED);			//NoSAK
+				return;
+			}
+		}
+	}
+	else
+	{
+		//----- BIT DRIVEN BY US (DATA OR MAK) -----
+		if (unio_irq_bit < 8)
+			bit_value = unio_irq_frame_byte & 0x80;
+		else
+			bit_value = unio_irq_frame_mak;
 
-			count++;
+		if (unio_irq_quarter == 0)
+		{
+			UNIO_SCIO_TRIS(0);						//Ensure SCIO is outputting
+			UNIO_SCIO_OUTPUT(bit_value ? 0 : 1);	//First half of bit, if 1 set SCIO low
+		}
+		else if (unio_irq_quarter == 2)
+		{
+			UNIO_SCIO_OUTPUT(bit_value ? 1 : 0);	//Second half of bit, if 1 set SCIO high
+		}
+		else if ((unio_irq_quarter == 3) && (unio_irq_bit < 8))
+		{
+			unio_irq_frame_byte <<= 1;
+		}
+	}
 
-			unio_read_error = 0;
-			unio_input_byte();						//Input byte
-			if (unio_read_error)
-				error_occured = 1;
+	//----- NEXT QUARTER -----
+	if (++unio_irq_quarter < 4)
+		return;
+	unio_irq_quarter = 0;
 
-			if (error_occured)
-				unio_data_in |= 0x01;
+	if ((++unio_irq_bit == 8) && (unio_irq_frame_is_rx))
+	{
+		if (!unio_irq_current->compare_data)
+		{
+			unio_irq_current->rx_data[unio_irq_frame - unio_irq_header_length - unio_irq_current->tx_length] = unio_irq_frame_byte;
 		}
-		if (count >= 120)
-			unio_comms_error = 1;
+		else if (unio_irq_current->compare_data[unio_irq_frame - unio_irq_header_length - unio_irq_current->tx_length] != unio_irq_frame_byte)
+		{
+			//Differs - NoMAK ends the read here
+			unio_irq_compare_different = 1;
+			unio_irq_frame_mak = 0;
+			unio_irq_frames = unio_irq_frame + 1;
+		}
+	}
 
-		unio_send_mak = 0;
-		unio_ack_sequence();
+	if (unio_irq_bit < 10)
+		return;
 
-		unio_idle();
+	//----- NEXT FRAME -----
+	if (++unio_irq_frame >= unio_irq_frames)
+	{
+		unio_irq_state = UNIO_IRQ_STATE_END;		//Ensure SCIO is high for bus idle at the end of the bit period
+		return;
 	}
+	unio_irq_load_frame();
+}
+#endif
+
+
+
+
+//********************************
+//********************************
+//********** STATISTICS **********
+//********************************
+//********************************
+//Copy of the runtime statistics (see UNIO_STATS).  Counts are not cleared, use unio_stats_reset().
+void unio_stats_read (UNIO_STATS *stats)
+{
+	DISABLE_INT;							//(Counts are also updated by the interrupt driven engine)
+	*stats = unio_stats;
+	ENABLE_INT;
+}
+
+void unio_stats_reset (void)
+{
+	uint8_t *p_stats = (uint8_t*)&unio_stats;
+	uint16_t count;
+
+	DISABLE_INT;
+	for (count = 0; count < sizeof(unio_stats); count++)
+		*p_stats++ = 0;
+	ENABLE_INT;
 }
 
 
+//Called just after DISABLE_INT and just before ENABLE_INT to add the time interrupts were disabled to the histogram.  Timed from
+//unio_bus_ticks, so to within a few quarter bit periods.
+void unio_stats_int_off_begin (void)
+{
+	unio_stats_int_off_ticks = unio_bus_ticks;
+	unio_stats_int_off_active = 1;
+}
+
+void unio_stats_int_off_end (void)
+{
+	uint32_t off_us;
+	uint32_t bin_us = UNIO_STATS_INT_OFF_BIN0_US;
+	uint8_t bin = 0;
 
+	if (!unio_stats_int_off_active)
+		return;								//(ENABLE_INT on an error path without DISABLE_INT)
+	unio_stats_int_off_active = 0;
 
+	off_us = UNIO_EEPROM_TICKS_TO_US(unio_bus_ticks - unio_stats_int_off_ticks);
+	while ((bin < (UNIO_STATS_INT_OFF_BINS - 1)) && (off_us >= bin_us))
+	{
+		bin++;
+		bin_us <<= 1;
+	}
 
+	unio_stats.int_off_count++;
+	unio_stats.int_off_histogram[bin]++;
+	if (off_us > unio_stats.int_off_max_us)
+		unio_stats.int_off_max_us = off_us;
+}
 
 
 
+//Bytes that can be sent or received in one transaction without the interrupt disabled period going over unio_int_off_budget_us, for a
+//transaction that starts with header_frames frames (including the start header) before the data bytes.  Worked out from the current
+//bus speed, so it is called again for each transaction.
+//Returns:
+//	Max data bytes (at least 1, even if the budget is too short for that), or 0xffff if there is no budget or the interrupt driven engine
+//	is used (interrupts are not disabled for transactions)
+uint16_t unio_int_off_max_bytes (uint8_t header_frames)
+{
+#ifdef UNIO_USE_IRQ_ENGINE
+	(void)header_frames;
+	return(0xffff);
+#else
+	uint32_t frame_us;
+	uint32_t overhead_us;
+
+	if (unio_int_off_budget_us == 0)
+		return(0xffff);
+
+	frame_us = UNIO_EEPROM_TICKS_TO_US(UNIO_EEPROM_TICKS_PER_FRAME);
+	if (frame_us == 0)
+		frame_us = 1;
+	overhead_us = UNIO_INT_OFF_SETUP_US + (frame_us * header_frames);
+	if ((uint32_t)unio_int_off_budget_us < (overhead_us + frame_us))
+		return(1);
+	if (((unio_int_off_budget_us - overhead_us) / frame_us) > 0xfffe)
+		return(0xfffe);
+	return((uint16_t)((unio_int_off_budget_us - overhead_us) / frame_us));
+#endif
+}
@@ -48,9 +48,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //##############################
 
 //N.B. THIS DRIVER REQURIES A HARDWARE TIMER AND DISABLES INTERRUPTS DURING READ AND WRITES TO ACHIIVE THE REQUIRED ACCURATE BIT TIMING.
+//(Unless UNIO_USE_IRQ_ENGINE is defined, in which case the bus is clocked from the timer interrupt instead - see below)
 /*
 	//----- INITIALISE -----
 	unio_eeprom_init();
+	unio_calibrate_bus_speed();		//Optional - run the bus as fast as this board allows (it slows down again by itself if errors rise)
 
 
 	//----- 1 WIRE EEPROM ------
@@ -73,6 +75,39 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 		Nop();
 	}
 
+	//Writes that may cross page boundaries
+	UNIO_BULK_WRITE_RESULT write_result;
+	if (unio_eeprom_write_bulk(0x0007, &data[0], UNIO_EEPROM_PAGE_SIZE, &write_result))
+	{
+		//Write Success (write_result.pages_written = 2)
+		Nop();
+	}
+
+	//Verify with a checksum later instead of reading back each page (unio_verify_policy is global)
+	uint16_t failed_address;
+	unio_verify_policy = UNIO_VERIFY_DEFERRED;
+	//...unio_eeprom_write() calls
+	if (!unio_eeprom_verify_deferred(&failed_address))
+	{
+		//A page written since the last call didn't verify (starting at failed_address)
+		Nop();
+	}
+
+	//Write without waiting for the write cycle (interrupts are not held off while the device programs the page)
+	if (unio_eeprom_write_start(0x0020, &data[0], UNIO_EEPROM_PAGE_SIZE))
+	{
+		//...do other things, the device only responds to a status read until the write cycle is complete
+		while (!unio_eeprom_is_write_complete())
+			Nop();
+	}
+
+	//Keep each interrupt disabled period under 2mS (bit banged driver) - reads are split into shorter transactions
+	//(each page WRITE is still one transaction, about 2mS for a full page at 100kHz)
+	unio_int_off_budget_us = 2000;
+	//...unio_eeprom_read() and unio_eeprom_write() calls
+	UNIO_STATS stats;
+	unio_stats_read(&stats);			//stats.int_off_max_us is the longest period actually used
+
 	for (count = 0; count < UNIO_EEPROM_PAGE_SIZE; count++)
 		data[count] = 0xff;
 	if (unio_eeprom_read(0x0000, &data[0], UNIO_EEPROM_PAGE_SIZE))
@@ -80,7 +115,85 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 		//Read Success
 		Nop();
 	}
+
+	//Compare without a buffer (the read stops at the first byte that differs)
+	if (unio_eeprom_compare(0x0000, &data[0], UNIO_EEPROM_PAGE_SIZE) == UNIO_EEPROM_PAGE_SIZE)
+	{
+		//Device already holds data (unio_eeprom_write() does this itself with UNIO_WRITE_SKIP_UNCHANGED)
+		Nop();
+	}
 	Nop();
+
+	//Reads may be any length (not limited to a page), e.g. load the whole device in one transaction
+	uint8_t image[UNIO_EEPROM_SIZE];
+	if (unio_eeprom_read(0x0000, &image[0], sizeof(image)))
+	{
+		//Read Success
+		Nop();
+	}
+*/
+
+//----- INTERRUPT DRIVEN ENGINE -----
+//The bus can also be run from the timer interrupt, leaving the CPU free between quarter bit periods.  Call unio_irq_tick() from the
+//timer interrupt (it clears the IRQ flag), the timer interrupt is only enabled while transactions are queued:
+/*
+	void __ISR(_TIMER_2_VECTOR, IPL5AUTO) timer2_isr (void)
+	{
+		unio_timer_isr();				//(Calls unio_irq_tick() while a transaction is in progress)
+	}
+
+	UNIO_TRANSACTION read_transaction;
+	uint8_t read_data[32];
+
+	read_transaction.command = 0x03;			//READ
+	read_transaction.send_address = 1;
+	read_transaction.address = 0x0000;
+	read_transaction.tx_length = 0;
+	read_transaction.rx_data = &read_data[0];
+	read_transaction.rx_length = sizeof(read_data);
+	read_transaction.callback = 0;
+	unio_irq_submit(&read_transaction);
+
+	//...later
+	if (unio_irq_poll(&read_transaction) == UNIO_IRQ_DONE)
+		Nop();
+*/
+
+//----- SHARING THE TIMER -----
+//The timer can be shared with one other user.  UNI/O borrows it for each bus transaction and then restores the other user's period and
+//re-enables its interrupt (the timer count restarts each time it changes hands).  The timer interrupt must call unio_timer_isr():
+/*
+	void my_timer_tick (void)			//Called by unio_timer_isr() while we have the timer
+	{
+		Nop();
+	}
+
+	unio_timer_other_register(2000, my_timer_tick);		//Our period (value for UNIO_EEPROM_OPEN_TIMER)
+	unio_eeprom_init();
+
+	unio_timer_other_lock();			//We need the timer without interruption - UNI/O waits or queues until unlocked
+	//...
+	unio_timer_other_unlock();
+*/
+
+//----- ERASE AND BLOCK PROTECTION -----
+//Whole device fill and the status register (each blocks until the write cycle is complete):
+/*
+	if (!unio_eeprom_erase_all())					//Every byte 0x00 (unio_eeprom_set_all() for 0xFF), fails if any block is protected
+		Nop();
+	unio_eeprom_write_protect(UNIO_EEPROM_PROTECT_UPPER_QUARTER);		//Lock the upper 1/4 of the array (e.g. calibration data)
+	unio_eeprom_read_status(&status);				//UNIO_EEPROM_STATUS_WIP, _WEL, _BP0, _BP1
+*/
+
+//----- STATISTICS -----
+//Retries, SAK and Manchester errors, WIP polls and interrupt disabled times are counted all the time, e.g. to spot a degrading board:
+/*
+	UNIO_STATS stats;
+
+	unio_stats_read(&stats);
+	if ((stats.sak_errors + stats.decode_errors) > (stats.reads / 100))
+		Nop();						//More than 1 bad transfer per 100 reads
+	unio_stats_reset();
 */
 
 
@@ -89,13 +202,33 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //********** MEMORY MAP **********
 //********************************
 //********************************
-//24LC010T
+//11AA/11LC family - select the part (11LC010 if none selected):
+//#define	UNIO_EEPROM_11XX010
+//#define	UNIO_EEPROM_11XX020
+//#define	UNIO_EEPROM_11XX040
+//#define	UNIO_EEPROM_11XX080
+//#define	UNIO_EEPROM_11XX160
+
 //Each eeprom:
-//1K bits = 128 x 8bit (0x00 - 0x7f)
 //Pages of 16 bytes may be written in a single operation, but they must be within the same 16 byte page (0x00-0x0F, 0x10-0x1F, etc)
+//2 address bytes are sent on all parts (address bits above the part size are ignored by the device, so accesses past the end would
+//wrap - reads and writes past UNIO_EEPROM_SIZE are rejected instead)
 //Eeprom max writes 1M cycles
+#if defined(UNIO_EEPROM_11XX160)
+#define	UNIO_EEPROM_SIZE					2048		//16K bits = 2048 x 8bit (0x000 - 0x7ff)
+#elif defined(UNIO_EEPROM_11XX080)
+#define	UNIO_EEPROM_SIZE					1024		//8K bits = 1024 x 8bit (0x000 - 0x3ff)
+#elif defined(UNIO_EEPROM_11XX040)
+#define	UNIO_EEPROM_SIZE					512			//4K bits = 512 x 8bit (0x000 - 0x1ff)
+#elif defined(UNIO_EEPROM_11XX020)
+#define	UNIO_EEPROM_SIZE					256			//2K bits = 256 x 8bit (0x00 - 0xff)
+#else
+#define	UNIO_EEPROM_SIZE					128			//1K bits = 128 x 8bit (0x00 - 0x7f)
+#endif
 
 #define	UNIO_EEPROM_PAGE_SIZE				16
+#define	UNIO_EEPROM_WRITE_CYCLE_US			5000		//Twc max (same for all parts)
+#define	UNIO_EEPROM_MAX_BUS_KHZ				100			//Max bit rate (same for all parts)
 
 //#define	UNIO_EEPROM_VALUE_0				0x0000
 //#define	UNIO_EEPROM_VALUE_0_LEN			4
@@ -112,18 +245,173 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define	UNIO_EEPROM_ADDRESS		0xa0
 
-//PIC32:
-#define	UNIO_SCIO_TRIS(data)					(data ? mPORTESetPinsDigitalIn(0x0004) : mPORTESetPinsDigitalOut(0x0004))
-#define	UNIO_SCIO_OUTPUT(data)					(data ? mPORTESetBits(0x0004) : mPORTEClearBits(0x0004))
-#define	UNIO_SCIO_INPUT							mPORTEReadBits(BIT_2)
-#define	UNIO_EEPROM_CLEAR_IRQ_FLAG()			INTClearFlag(INT_T2)
-#define	UNIO_EEPROM_READ_IRQ_FLAG()				INTGetFlag(INT_T2)
-#define	UNIO_EEPROM_WRITE_TIMER(data)			WriteTimer2(data)
-#define	UNIO_EEPROM_TIMER_QUARTER_PERIOD		500		//2.5uS - 25uS to give 10kHz to 100kHz.  Our 20Mhz peripheral bus clock = 50nS.  2.5uS / 50nS = 50.  25uS / 50nS = 500
-														//You must ensure bit timing it complelty accurate, make slower if there is risk of fucntion calls etc being too slow for bitrate you have set.
+//----- HARDWARE ABSTRACTION -----
+//The SCIO pin and timer macros are bound at compile time so they inline straight into the quarter bit loops (no function pointer calls).
+//They come from one HAL header - define UNIO_HAL_HEADER for your own (e.g. -DUNIO_HAL_HEADER=\"my-board-unio-hal.h\", copy
+//mem-11lcxxx-hal-pic32.h as a starting point), UNIO_HAL_HOST_SIM for the host simulator, or neither for PIC32.  No driver changes are
+//needed to port.
+#if defined(UNIO_HAL_HEADER)
+#include UNIO_HAL_HEADER
+#elif defined(UNIO_HAL_HOST_SIM)
+#include "mem-11lcxxx-hal-sim.h"
+#else
+#include "mem-11lcxxx-hal-pic32.h"
+#endif
+
+#if (!defined(UNIO_SCIO_TRIS) || !defined(UNIO_SCIO_OUTPUT) || !defined(UNIO_SCIO_INPUT) || !defined(UNIO_EEPROM_CLEAR_IRQ_FLAG) || \
+	!defined(UNIO_EEPROM_READ_IRQ_FLAG) || !defined(UNIO_EEPROM_WRITE_TIMER) || !defined(UNIO_EEPROM_OPEN_TIMER) || \
+	!defined(UNIO_EEPROM_TIMER_QUARTER_PERIOD) || !defined(UNIO_EEPROM_TIMER_MIN_QUARTER_PERIOD) || !defined(UNIO_EEPROM_TIMER_COUNT_NS) || \
+	!defined(UNIO_EEPROM_ENABLE_TIMER_IRQ) || !defined(UNIO_EEPROM_DISABLE_TIMER_IRQ) || !defined(UNIO_EEPROM_IDLE_WAIT))
+#error The UNI/O HAL header is missing a required macro (see mem-11lcxxx-hal-pic32.h)
+#endif
+
+//#define	UNIO_USE_IRQ_ENGINE								//Comment out to bit bang the bus with interrupts disabled (original driver).  Define to run the
+																//blocking functions on top of the interrupt driven engine - the CPU is free between quarter bit timer
+																//interrupts.  unio_irq_tick() must be called from the timer interrupt.
+
+//#define	UNIO_USE_ENCODED_FRAMES							//Define to Manchester-encode the outbound frames of reads and writes before interrupts are
+																//disabled and play them out from a tight loop (bit banged driver only).  There are no function
+																//calls or decisions in the output bit timing, so UNIO_EEPROM_TIMER_QUARTER_PERIOD can be
+																//reduced towards the 100kHz bus maximum.
+#define	UNIO_ENCODED_MAX_FRAMES					(5 + UNIO_EEPROM_PAGE_SIZE)		//Header, device address, command, address H, address L + a page of data
+#define	UNIO_ENCODED_CHECK_SAK					0x80000000		//unio_encoded_frames[] flag, frame has a SAK to check
+
+//#define	UNIO_USE_EDGE_DECODER							//Define to decode bytes read from the device from the times of the SCIO edges seen by
+																//UNIO_SCIO_CAPTURE_READ() (input capture), tracking the device's clock instead of sampling at
+																//fixed points.  Tolerates twice the clock skew, so fewer retries at high bit rates and on long
+																//cables.  Bit banged driver only.
+//#define	UNIO_USE_READ_CACHE								//Define to keep recently read pages in RAM, so repeated unio_eeprom_read() calls for the same
+																//fields are served without a bus transaction (LRU, see UNIO_READ_CACHE_PAGES).  Writes through
+																//the driver invalidate the pages they write.
+#define	UNIO_READ_CACHE_PAGES					4		//RAM used = this x UNIO_EEPROM_PAGE_SIZE bytes
+#define	UNIO_READ_CACHE_READ_AHEAD				1		//Pages after a missed page fetched in the same READ (must be less than UNIO_READ_CACHE_PAGES)
+#define	UNIO_READ_CACHE_EMPTY					0xffff	//unio_read_cache_page[] value for an empty slot
+
+#define	UNIO_SCIO_NO_CAPTURE					0xffff	//UNIO_SCIO_CAPTURE_READ() return value when no more edges have been captured
+#define	UNIO_EDGE_MAX_EDGES						20		//Edges stored per byte (8 mid bit + up to 8 bit boundary edges)
+#define	UNIO_EDGE_MARGIN						(unio_quarter_period / 8)		//Min timer counts between a mid bit edge and the level sample that decodes it
+
+#define	UNIO_CALIBRATE_PROBES					8		//Reads at each speed by unio_calibrate_bus_speed(), all must be good
+#define	UNIO_CALIBRATE_MARGIN_PERCENT			25		//Calibrated speed is the fastest good speed with its quarter period made this much longer
+#define	UNIO_SPEED_STEP_PERCENT					20		//Quarter period change per calibration or fall back step
+#define	UNIO_SPEED_WINDOW						64		//unio_speed_feedback() - read/write attempts per window
+#define	UNIO_SPEED_MAX_ERRORS					2		//unio_speed_feedback() - failed attempts allowed per window before slowing down
+
+#define	UNIO_WRITE_CYCLE_BANDS					4		//Number of temperature bands the write cycle time is learnt for (see unio_write_cycle_band)
+
+#define	UNIO_WRITE_SKIP_UNCHANGED						//unio_eeprom_write() compares the data with the device first and skips the write cycle if it's
+														//already the same (a short read, ended at the first byte that differs).  Comment out to always write.
+#define	UNIO_COMPARE_FAILED						0xffff	//unio_eeprom_compare() return value when the device couldn't be read
+#define	UNIO_WRITE_FAILED						0		//unio_eeprom_write_report() return values
+#define	UNIO_WRITE_DONE							1
+#define	UNIO_WRITE_SKIPPED						2		//(UNIO_WRITE_SKIP_UNCHANGED found the device already held the data, no write cycle)
+
+#define	UNIO_EEPROM_STATUS_WIP					0x01		//Status register - write in progress
+#define	UNIO_EEPROM_STATUS_WEL					0x02		//Status register - write enable latch
+#define	UNIO_EEPROM_STATUS_BP0					0x04		//Status register - block protect bits
+#define	UNIO_EEPROM_STATUS_BP1					0x08
+#define	UNIO_EEPROM_PROTECT_NONE				0x00		//unio_eeprom_write_protect() values
+#define	UNIO_EEPROM_PROTECT_UPPER_QUARTER		0x04
+#define	UNIO_EEPROM_PROTECT_UPPER_HALF			0x08
+#define	UNIO_EEPROM_PROTECT_ALL					0x0c
+
+//Write verify policies (unio_verify_policy), how unio_eeprom_write() and unio_eeprom_write_bulk() check each page they write:
+#define	UNIO_VERIFY_READ_BACK					0		//Read the page back and compare straight after the write cycle (default)
+#define	UNIO_VERIFY_NONE						1		//No verify (for applications with their own integrity checks)
+#define	UNIO_VERIFY_SAMPLED						2		//Read back 1 in every UNIO_VERIFY_SAMPLE_INTERVAL writes
+#define	UNIO_VERIFY_DEFERRED					3		//Store a checksum of each write, unio_eeprom_verify_deferred() later checks them in sequential reads
+#define	UNIO_VERIFY_SAMPLE_INTERVAL				8
+#define	UNIO_VERIFY_DEFERRED_MAX				16		//Writes stored for a deferred verify (when full the next write verifies them first)
+#define	UNIO_VERIFY_DEFERRED_MAX_GAP			8		//Bytes between deferred writes that are read through rather than starting a new READ transaction
+
+#define	UNIO_STATS_INT_OFF_BINS					10		//Interrupt disabled time histogram bins (see UNIO_STATS)
+#define	UNIO_STATS_INT_OFF_BIN0_US				250		//Bin 0 is periods shorter than this, each bin after is twice as long (the last bin has all longer periods)
+
+//Convert a count of quarter bit periods (unio_bus_ticks) to uS
+#define	UNIO_EEPROM_TICKS_TO_US(ticks)			(((uint32_t)(ticks) * (((uint32_t)unio_quarter_period * UNIO_EEPROM_TIMER_COUNT_NS) / 10)) / 100)		//(At the current bus speed)
+#define	UNIO_EEPROM_TICKS_PER_FRAME				40		//8 data bits, MAK and SAK
+#define	UNIO_INT_OFF_SETUP_US					20		//Tss, Thdr and call overhead allowed in each interrupt disabled period (see unio_int_off_budget_us)
+#define	UNIO_EEPROM_US_TO_TICKS(us)				(((uint32_t)(us) * 100) / (((uint32_t)unio_quarter_period * UNIO_EEPROM_TIMER_COUNT_NS) / 10))
+
+//Interrupt driven engine states (unio_irq_state)
+#define	UNIO_IRQ_STATE_IDLE						0
+#define	UNIO_IRQ_STATE_SETUP					1		//SCIO high for Tss (or Tstby after a failed transaction)
+#define	UNIO_IRQ_STATE_HEADER_LOW				2		//SCIO low for Thdr
+#define	UNIO_IRQ_STATE_BITS						3
+#define	UNIO_IRQ_STATE_END						4
+
+typedef enum _UNIO_IRQ_STATUS
+{
+	UNIO_IRQ_IDLE,
+	UNIO_IRQ_BUSY,								//Queued or in progress
+	UNIO_IRQ_DONE,
+	UNIO_IRQ_FAILED								//Missing SAK or bad Manchester bit - transaction was aborted at that point
+} UNIO_IRQ_STATUS;
+
+//A bus transaction for the interrupt driven engine:
+//Start header, device address, command, [address H, address L], [tx_length bytes written], [rx_length bytes read]
+typedef struct _UNIO_TRANSACTION
+{
+	uint8_t command;
+	uint8_t send_address;						//1 to send address after the command
+	uint16_t address;
+	uint8_t *tx_data;
+	uint16_t tx_length;
+	uint8_t *rx_data;
+	uint16_t rx_length;
+	uint16_t rx_done;							//Set when the transaction ends - bytes of rx_data received (all of them unless it failed)
+	uint8_t *compare_data;						//Optional - rx bytes are compared with this instead of being stored in rx_data, the read is ended
+												//with a NoMAK at the first byte that differs and rx_done is the number that matched
+	void (*callback)(struct _UNIO_TRANSACTION *transaction);		//Optional, called from the timer interrupt when the transaction ends
+	volatile UNIO_IRQ_STATUS status;
+	struct _UNIO_TRANSACTION *next;				//(Used by the queue)
+} UNIO_TRANSACTION;
+
+typedef struct _UNIO_BULK_WRITE_RESULT
+{
+	uint16_t pages_written;						//Page write cycles used (including any rewrites)
+	uint32_t bus_ticks;							//Bus time in quarter bit periods, including write cycle WIP polling (see UNIO_EEPROM_TICKS_TO_US)
+} UNIO_BULK_WRITE_RESULT;
+
+typedef struct _UNIO_VERIFY_RECORD
+{
+	uint16_t address;
+	uint8_t length;
+	uint16_t checksum;							//Fletcher-16 (modulo 256) of the bytes written
+} UNIO_VERIFY_RECORD;
+
+//Runtime statistics, always counted (see unio_stats_read() and unio_stats_reset())
+typedef struct _UNIO_STATS
+{
+	uint32_t reads;								//unio_eeprom_read() and unio_eeprom_compare() calls (including write read back)
+	uint32_t writes;							//unio_eeprom_write() calls
+	uint32_t writes_skipped;					//unio_eeprom_write() calls with data already the same on the device (UNIO_WRITE_SKIP_UNCHANGED)
+	uint32_t read_cache_hits;					//Pages read from the read cache (UNIO_USE_READ_CACHE)
+	uint32_t read_cache_misses;					//Pages fetched from the device into the read cache
+	uint32_t bulk_writes;						//unio_eeprom_write_bulk() calls
+	uint32_t presence_checks;					//unio_is_eeprom_present() calls
+	uint32_t failures;							//Reads and writes that failed after all retries
+	uint32_t read_retries;						//Read attempts repeated after a failed attempt
+	uint32_t write_retries;						//Page write attempts repeated after a failed attempt or verify
+	uint32_t verify_errors;						//Write read backs that didn't match
+	uint32_t sak_errors;						//Missing SAKs (includes presence checks with no device)
+	uint32_t decode_errors;						//Bytes read with a bad Manchester bit (unio_read_error)
+	uint32_t standby_pulses;					//Including the standby pulse after each failed transaction
+	uint32_t wip_polls;							//Status register reads while waiting for write cycles
+	uint32_t wip_timeouts;						//Write cycles not seen to complete
+	uint32_t int_off_count;						//Periods with interrupts disabled by the driver (DISABLE_INT to ENABLE_INT)
+	uint32_t int_off_max_us;					//Longest of them (the largest window actually used when unio_int_off_budget_us is set)
+	uint32_t int_off_histogram[UNIO_STATS_INT_OFF_BINS];		//Periods by length, see UNIO_STATS_INT_OFF_BIN0_US
+} UNIO_STATS;
+
+//UNIO_SCIO_CAPTURE_READ() returns the timer count at the oldest SCIO edge captured in the timer period that has just ended (it is
+//called as soon as the IRQ flag is seen), or UNIO_SCIO_NO_CAPTURE if there are no more.
+
 //Also set for this device/project:
-//	unio_setup_timer_for_unio_use()		<<<Setup hardware timer
+//	unio_setup_timer_for_unio_use()		<<<Setup hardware timer (see also unio_timer_other_register() to share it)
 //	unio_delay_5us()
+//To port to another device provide the same set of macros in a HAL header (see UNIO_HAL_HEADER above).  Define UNIO_HAL_HOST_SIM to run
+//the driver on a PC against the simulated 11LCxxx in mem-11lcxxx-sim.c (no other changes needed).
 
 
 
@@ -140,34 +428,123 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //-----------------------------------
 //----- INTERNAL ONLY FUNCTIONS -----
 //-----------------------------------
-void unio_delay_5us (uint16_t delay_5us);
 void unio_start_header (void);
 void unio_output_byte(void);
+void unio_output_byte_checked (uint8_t value);
 void unio_input_byte (void);
 void unio_input_bit (void);
 void unio_write_enable (void);
 void unio_ack_sequence (void);
-void unio_standby (void);
-void unio_wait_for_write_complete (void);
+void unio_idle (void);
+BYTE unio_wait_for_write_complete (void);
+void unio_timer_give_back (void);
+void unio_irq_start_transaction (void);
+void unio_irq_load_frame (void);
+void unio_irq_end_transaction (UNIO_IRQ_STATUS status);
+BYTE unio_irq_run (UNIO_TRANSACTION *transaction);
+void unio_irq_load_transaction (UNIO_TRANSACTION *transaction, uint8_t command, uint8_t send_address, uint16_t address);
+BYTE unio_eeprom_write_page (uint16_t address, uint8_t *data, uint8_t length);
+void unio_delay_quarters (uint32_t quarters);
+void unio_speed_feedback (BYTE success);
+uint16_t unio_eeprom_verify (uint16_t address, uint8_t *data, uint16_t length);
+void unio_input_byte_edges (void);
+void unio_encode_begin (void);
+BYTE unio_encode_byte (uint8_t value, uint8_t send_mak);
+BYTE unio_encoded_play (void);
+uint16_t unio_verify_checksum (uint8_t *data, uint8_t length);
+void unio_verify_deferred_add (uint16_t address, uint8_t *data, uint8_t length);
+void unio_verify_deferred_check (void);
+BYTE unio_verify_deferred_run (uint8_t first, uint8_t last);
+BYTE unio_eeprom_fill_all (uint8_t command);
+BYTE unio_eeprom_write_cycle_command (uint8_t command, uint8_t *data, uint8_t length);
+BYTE unio_eeprom_command (uint8_t command, uint8_t write_enable, uint8_t *data, uint8_t length);
+BYTE unio_eeprom_read_device (uint16_t address, uint8_t *data, uint16_t length);
+BYTE unio_read_cache_read (uint16_t address, uint8_t *data, uint16_t length);
+uint8_t unio_read_cache_fetch (uint16_t page);
+void unio_read_cache_invalidate_range (uint16_t address, uint16_t length);
+uint16_t unio_int_off_max_bytes (uint8_t header_frames);
+uint16_t unio_eeprom_verify_once (uint16_t address, uint8_t *data, uint16_t length);
 
 
 //-----------------------------------------
 //----- INTERNAL & EXTERNAL FUNCTIONS -----
 //-----------------------------------------
 //(Also defined below as extern)
+void unio_setup_timer_for_unio_use (void);
+void unio_delay_5us (uint16_t delay_5us);
+void unio_set_bus_speed (uint16_t quarter_period);
+void unio_timer_acquire (void);
+void unio_timer_release (void);
+void unio_timer_other_register (uint16_t period, void (*isr)(void));
+void unio_timer_other_lock (void);
+void unio_timer_other_unlock (void);
+void unio_timer_isr (void);
+void unio_eeprom_init (void);
 BYTE unio_is_eeprom_present (void);
 BYTE unio_eeprom_write (uint16_t address, uint8_t *data, uint8_t length);
-BYTE unio_eeprom_read (uint16_t address, uint8_t *data, uint8_t length);
+uint8_t unio_eeprom_write_report (uint16_t address, uint8_t *data, uint8_t length);
+BYTE unio_eeprom_write_bulk (uint16_t address, uint8_t *data, uint16_t length, UNIO_BULK_WRITE_RESULT *result);
+BYTE unio_eeprom_write_start (uint16_t address, uint8_t *data, uint8_t length);
+BYTE unio_eeprom_is_write_complete (void);
+BYTE unio_eeprom_read_status (uint8_t *status);
+BYTE unio_eeprom_erase_all (void);
+BYTE unio_eeprom_set_all (void);
+BYTE unio_eeprom_write_protect (uint8_t block_protect);
+BYTE unio_eeprom_write_disable (void);
+BYTE unio_eeprom_read (uint16_t address, uint8_t *data, uint16_t length);
+BYTE unio_eeprom_read_once (uint16_t address, uint8_t *data, uint16_t length);
+uint16_t unio_eeprom_compare (uint16_t address, uint8_t *data, uint16_t length);
+void unio_read_cache_invalidate (void);
+BYTE unio_eeprom_verify_deferred (uint16_t *failed_address);
+BYTE unio_calibrate_bus_speed (void);
 void unio_standby_pulse (void);
+BYTE unio_irq_submit (UNIO_TRANSACTION *transaction);
+UNIO_IRQ_STATUS unio_irq_poll (UNIO_TRANSACTION *transaction);
+void unio_irq_tick (void);
+void unio_stats_read (UNIO_STATS *stats);
+void unio_stats_reset (void);
+void unio_stats_int_off_begin (void);
+void unio_stats_int_off_end (void);
 
 #else
 //------------------------------
 //----- EXTERNAL FUNCTIONS -----
 //------------------------------
+extern void unio_setup_timer_for_unio_use (void);
+extern void unio_delay_5us (uint16_t delay_5us);
+extern void unio_set_bus_speed (uint16_t quarter_period);
+extern void unio_timer_acquire (void);
+extern void unio_timer_release (void);
+extern void unio_timer_other_register (uint16_t period, void (*isr)(void));
+extern void unio_timer_other_lock (void);
+extern void unio_timer_other_unlock (void);
+extern void unio_timer_isr (void);
+extern void unio_eeprom_init (void);
 extern BYTE unio_is_eeprom_present (void);
 extern BYTE unio_eeprom_write (uint16_t address, uint8_t *data, uint8_t length);
-extern BYTE unio_eeprom_read (uint16_t address, uint8_t *data, uint8_t length);
-void unio_standby_pulse (void);
+extern uint8_t unio_eeprom_write_report (uint16_t address, uint8_t *data, uint8_t length);
+extern BYTE unio_eeprom_write_bulk (uint16_t address, uint8_t *data, uint16_t length, UNIO_BULK_WRITE_RESULT *result);
+extern BYTE unio_eeprom_write_start (uint16_t address, uint8_t *data, uint8_t length);
+extern BYTE unio_eeprom_is_write_complete (void);
+extern BYTE unio_eeprom_read_status (uint8_t *status);
+extern BYTE unio_eeprom_erase_all (void);
+extern BYTE unio_eeprom_set_all (void);
+extern BYTE unio_eeprom_write_protect (uint8_t block_protect);
+extern BYTE unio_eeprom_write_disable (void);
+extern BYTE unio_eeprom_read (uint16_t address, uint8_t *data, uint16_t length);
+extern BYTE unio_eeprom_read_once (uint16_t address, uint8_t *data, uint16_t length);
+extern uint16_t unio_eeprom_compare (uint16_t address, uint8_t *data, uint16_t length);
+extern void unio_read_cache_invalidate (void);
+extern BYTE unio_eeprom_verify_deferred (uint16_t *failed_address);
+extern BYTE unio_calibrate_bus_speed (void);
+extern void unio_standby_pulse (void);
+extern BYTE unio_irq_submit (UNIO_TRANSACTION *transaction);
+extern UNIO_IRQ_STATUS unio_irq_poll (UNIO_TRANSACTION *transaction);
+extern void unio_irq_tick (void);
+extern void unio_stats_read (UNIO_STATS *stats);
+extern void unio_stats_reset (void);
+extern void unio_stats_int_off_begin (void);
+extern void unio_stats_int_off_end (void);
 
 #endif
 
@@ -191,20 +568,88 @@ uint8_t unio_read_error;
 uint8_t unio_input_bit_read;
 uint8_t unio_count;
 uint8_t unio_temp_data_buffer[UNIO_EEPROM_PAGE_SIZE];
+#ifdef UNIO_USE_READ_CACHE
+uint8_t unio_read_cache_data[UNIO_READ_CACHE_PAGES * UNIO_EEPROM_PAGE_SIZE];
+uint16_t unio_read_cache_page[UNIO_READ_CACHE_PAGES];		//Device page held by each slot, or UNIO_READ_CACHE_EMPTY
+uint16_t unio_read_cache_used[UNIO_READ_CACHE_PAGES];		//unio_read_cache_clock when each slot was last read (0 = never)
+uint16_t unio_read_cache_clock;
+#endif
+
+#ifdef UNIO_USE_IRQ_ENGINE
+UNIO_TRANSACTION *unio_irq_current;
+UNIO_TRANSACTION *unio_irq_last;
+uint8_t unio_irq_state;
+uint8_t unio_irq_need_standby;
+uint8_t unio_irq_quarter_count;
+uint8_t unio_irq_quarter;
+uint8_t unio_irq_bit;
+uint16_t unio_irq_frame;
+uint16_t unio_irq_frames;
+uint8_t unio_irq_frame_byte;
+uint8_t unio_irq_frame_mak;
+uint8_t unio_irq_frame_is_rx;
+uint8_t unio_irq_compare_different;
+uint8_t unio_irq_sample;
+uint8_t unio_irq_header[5];
+uint8_t unio_irq_header_length;
+#endif
+uint32_t unio_write_start_ticks;
+uint8_t unio_timer_users;						//Nesting count of unio_timer_acquire()
+uint8_t unio_timer_is_ours;						//Timer is setup for UNI/O
+uint8_t unio_timer_other_registered;
+uint16_t unio_timer_other_period;
+void (*unio_timer_other_isr)(void);
+volatile uint8_t unio_timer_other_locked;
+#ifdef UNIO_USE_ENCODED_FRAMES
+uint32_t unio_encoded_frames[UNIO_ENCODED_MAX_FRAMES];		//Bits 17:0 = half bit SCIO levels, first level in bit 17
+uint8_t unio_encoded_frame_count;
+#endif
+#ifdef UNIO_USE_EDGE_DECODER
+uint32_t unio_edge_times[UNIO_EDGE_MAX_EDGES];		//Timer counts from the start of the byte being read
+uint8_t unio_edge_count;
+#endif
+uint8_t unio_speed_attempts;
+uint8_t unio_speed_errors;
+UNIO_VERIFY_RECORD unio_verify_records[UNIO_VERIFY_DEFERRED_MAX];
+uint8_t unio_verify_record_count;
+uint8_t unio_verify_sample_count;
+uint8_t unio_verify_deferred_failed;			//A deferred verify failed since unio_eeprom_verify_deferred() was last called
+uint16_t unio_verify_failed_address;
+uint32_t unio_stats_int_off_ticks;				//unio_bus_ticks at DISABLE_INT
+uint8_t unio_stats_int_off_active;
 
 
 //--------------------------------------------------
 //----- INTERNAL & EXTERNAL MEMORY DEFINITIONS -----
 //--------------------------------------------------
 //(Also defined below as extern)
-
+uint32_t unio_bus_ticks;					//Free running count of quarter bit periods the bus has been clocked for
+uint16_t unio_quarter_period;				//Current bus speed, timer period per quarter bit (see unio_set_bus_speed())
+uint16_t unio_read_good_length;				//unio_eeprom_read_once() - bytes at the start of data that were read correctly (on failure)
+uint8_t unio_quarters_per_5us;				//Quarter bit periods in each 5uS of min time (1 unless the bus is faster than 50kHz)
+uint8_t unio_write_cycle_band;				//Set by the application from its temperature reading (0 to UNIO_WRITE_CYCLE_BANDS - 1), the write
+											//cycle time is learnt separately for each band as it gets longer at the temperature extremes
+uint16_t unio_write_cycle_ticks[UNIO_WRITE_CYCLE_BANDS];		//Learnt write cycle time in quarter bit periods for each band (0 = not yet known)
+uint8_t unio_verify_policy;					//UNIO_VERIFY_READ_BACK etc, may be changed at any time
+UNIO_STATS unio_stats;						//Also counted by mem-11lcxxx-multi.c (applications use unio_stats_read())
+uint16_t unio_int_off_budget_us;			//Max time interrupts may be disabled for in uS, 0 = no limit, may be changed at any time (bit banged driver).
+											//Reads are split to fit, but a page is never split into several write cycles (that would cost
+											//wear and write cycle time per page) - a budget shorter than one page WRITE is exceeded by it
 
 
 #else
 //---------------------------------------
 //----- EXTERNAL MEMORY DEFINITIONS -----
 //---------------------------------------
-
+extern uint32_t unio_bus_ticks;
+extern uint16_t unio_quarter_period;
+extern uint16_t unio_read_good_length;
+extern uint8_t unio_quarters_per_5us;
+extern uint8_t unio_write_cycle_band;
+extern uint16_t unio_write_cycle_ticks[UNIO_WRITE_CYCLE_BANDS];
+extern uint8_t unio_verify_policy;
+extern UNIO_STATS unio_stats;
+extern uint16_t unio_int_off_budget_us;
 
 
 
@@ -0,0 +1,20 @@
+//Host build of the global data type definitions (see https://github.com/ibexuk/C_Generic_Header_File ) for the host tests and tools.
+//DISABLE_INT / ENABLE_INT go to the simulator so interrupt disabled times are measured (see mem-11lcxxx-bench.h), and a test can
+//change the device contents part way through a driver call with unio_sim_disable_int_hook.
+
+#ifndef MAIN_H_INIT
+#define	MAIN_H_INIT
+
+#include <stdint.h>
+
+typedef unsigned char BYTE;
+
+void unio_sim_disable_int (void);
+void unio_sim_enable_int (void);
+
+#define	DISABLE_INT					unio_sim_disable_int()
+#define	ENABLE_INT					unio_sim_enable_int()
+#define	Nop()
+
+
+#endif
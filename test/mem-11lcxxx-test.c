@@ -0,0 +1,1514 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name: 11LC010T EEPROM USING UNI/O 1 WIRE BUS - HOST TESTS
+
+
+
+#include "main.h"					//Global data type definitions (see https://github.com/ibexuk/C_Generic_Header_File )
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define	MEM_EXT_UNIO_TEST_C		//(Our header file define)
+
+#include "mem-11lcxxx-test.h"
+#include "mem-11lcxxx-sim.h"
+#include "mem-11lcxxx-bench.h"
+#include "mem-11lcxxx-cache.h"
+#include "mem-11lcxxx-kv.h"
+#include "mem-11lcxxx-image.h"
+#include "mem-11lcxxx-batch.h"
+#include "mem-11lcxxx-multi.h"
+
+
+
+//**************************
+//**************************
+//********** MAIN **********
+//**************************
+//**************************
+int main (int argc, char **argv)
+{
+	//----- BENCHMARKS -----
+	if ((argc >= 2) && (strcmp(argv[1], "--bench-csv") == 0))
+	{
+		unio_bench_run();
+		return(0);
+	}
+	if ((argc >= 3) && (strcmp(argv[1], "--bench") == 0))
+	{
+		if (!unio_bench_check(argv[2], (argc >= 4) ? (uint8_t)atoi(argv[3]) : UNIO_TEST_BENCH_THRESHOLD))
+		{
+			printf("bench: FAILED against %s\n", argv[2]);
+			return(1);
+		}
+		printf("bench: passed against %s\n", argv[2]);
+		return(0);
+	}
+
+	//----- TESTS -----
+	unio_test_seed = UNIO_TEST_SEED;
+
+	unio_test_simulator();
+	unio_test_bulk_rewrite();
+	unio_test_read_write();
+	unio_test_write_start();
+	unio_test_irq_engine();
+	unio_test_write_cache();
+	unio_test_write_cycle_learning();
+	unio_test_multi();
+	unio_test_kv();
+	unio_test_clock_skew();
+	unio_test_timer_sharing();
+	unio_test_int_off_balance();
+	unio_test_calibration();
+	unio_test_glitch();
+	unio_test_verify_policies();
+	unio_test_image();
+	unio_test_erase_protect();
+	unio_test_read_cache();
+	unio_test_skip_unchanged();
+	unio_test_int_off_budget();
+	unio_test_batch();
+
+	printf("%lu checks, %lu failed\n", (unsigned long)unio_test_checks, (unsigned long)unio_test_failures);
+	return(unio_test_failures ? 1 : 0);
+}
+
+
+
+//***************************
+//***************************
+//********** CHECK **********
+//***************************
+//***************************
+void unio_test_check (uint8_t passed, const char *condition, int line)
+{
+	unio_test_checks++;
+	if (passed)
+		return;
+
+	unio_test_failures++;
+	printf("FAIL %s (line %d): %s\n", unio_test_name, line, condition);
+}
+
+
+//Returns:
+//	Next byte of a fixed sequence (LCG), so every run is the same
+uint8_t unio_test_random (void)
+{
+	unio_test_seed = (unio_test_seed * 1103515245) + 12345;
+	return((uint8_t)(unio_test_seed >> 16));
+}
+
+
+//Power on a fresh simulated device (erased to 0xFF) and the driver at a bus speed
+void unio_test_power_on (uint16_t quarter_period)
+{
+	unio_sim_reset();
+	unio_sim_device.size = UNIO_EEPROM_SIZE;			//(The simulator defaults to an 11LC010)
+	unio_set_bus_speed(quarter_period);
+	unio_eeprom_init();
+	unio_stats_reset();
+	unio_verify_policy = UNIO_VERIFY_READ_BACK;
+	unio_int_off_budget_us = 0;
+	memset(&unio_test_model[0], 0xff, sizeof(unio_test_model));
+}
+
+
+//Call after changing unio_sim_device.memory[] directly
+void unio_test_device_changed (void)
+{
+#ifdef UNIO_USE_READ_CACHE
+	unio_read_cache_invalidate();
+#endif
+}
+
+
+
+
+
+//*******************************
+//*******************************
+//********** SIMULATOR **********
+//*******************************
+//*******************************
+//mem-11lcxxx-sim.c - the device needs its standby pulse, accepts a page write and reads it back, and the virtual time is counted
+void unio_test_simulator (void)
+{
+	uint8_t count;
+	uint64_t start_time;
+
+	unio_test_name = "simulator";
+	unio_test_power_on(UNIO_EEPROM_TIMER_QUARTER_PERIOD);
+
+	UNIO_TEST_CHECK(unio_is_eeprom_present());
+	UNIO_TEST_CHECK(unio_sim_stats.transactions == 1);
+
+	for (count = 0; count < UNIO_EEPROM_PAGE_SIZE; count++)
+		unio_test_data[count] = (uint8_t)(count * 3);
+	UNIO_TEST_CHECK(unio_eeprom_write(0x0010, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE));
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0x0010], &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == 0);
+	UNIO_TEST_CHECK(unio_sim_stats.write_cycles == 1);
+
+	start_time = unio_sim_stats.elapsed_ns;
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0010, &unio_test_read_data[0], UNIO_EEPROM_PAGE_SIZE));
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == 0);
+	UNIO_TEST_CHECK((unio_sim_stats.elapsed_ns - start_time) >= ((uint64_t)(4 + UNIO_EEPROM_PAGE_SIZE) * 10 * 100000));		//(Frames x 10 bits x 100uS at 10kHz)
+	UNIO_TEST_CHECK(unio_sim_stats.bus_errors == 0);
+
+	//----- NO STANDBY PULSE AFTER POWER ON -----
+	unio_sim_reset();
+	unio_set_bus_speed(UNIO_EEPROM_TIMER_QUARTER_PERIOD);			//(Timer setup again on the reset simulator)
+	UNIO_TEST_CHECK(!unio_eeprom_read_once(0x0010, &unio_test_read_data[0], 1));
+	UNIO_TEST_CHECK(unio_sim_stats.transactions == 0);
+}
+
+
+
+//********************************
+//********************************
+//********** READ WRITE **********
+//********************************
+//********************************
+//Random single page writes and random reads of any length against the RAM model
+void unio_test_read_write (void)
+{
+	uint16_t count;
+	uint16_t address;
+	uint8_t length;
+	uint8_t index;
+	uint8_t bad = 0;
+	uint32_t transactions;
+
+	unio_test_name = "read_write";
+	unio_test_power_on(500);
+
+	UNIO_TEST_CHECK(unio_is_eeprom_present());
+
+	for (count = 0; count < UNIO_TEST_RANDOM_OPS; count++)
+	{
+		address = unio_test_random() % UNIO_EEPROM_SIZE;
+		length = 1 + (unio_test_random() % (UNIO_EEPROM_PAGE_SIZE * 3));		//(Reads over several pages)
+		if ((address + length) > UNIO_EEPROM_SIZE)
+			length = (uint8_t)(UNIO_EEPROM_SIZE - address);
+
+		if (unio_test_random() & 0x01)
+		{
+			if ((address / UNIO_EEPROM_PAGE_SIZE) != ((address + length - 1) / UNIO_EEPROM_PAGE_SIZE))
+				length = (uint8_t)(UNIO_EEPROM_PAGE_SIZE - (address % UNIO_EEPROM_PAGE_SIZE));		//(Single page)
+			for (index = 0; index < length; index++)
+				unio_test_data[index] = unio_test_random();
+
+			if (!unio_eeprom_write(address, &unio_test_data[0], length))
+				bad++;
+			memcpy(&unio_test_model[address], &unio_test_data[0], length);
+		}
+		else
+		{
+			if (!unio_eeprom_read(address, &unio_test_read_data[0], length))
+				bad++;
+			if (memcmp(&unio_test_read_data[0], &unio_test_model[address], length) != 0)
+				bad++;
+		}
+	}
+	UNIO_TEST_CHECK(bad == 0);
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+
+	//----- WHOLE DEVICE SEQUENTIAL READ -----
+	transactions = unio_sim_stats.transactions;
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0000, &unio_test_read_data[0], UNIO_EEPROM_SIZE));
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+	UNIO_TEST_CHECK(unio_sim_stats.transactions == (transactions + 1));		//(A single READ)
+
+	//----- PAST THE END OF THE DEVICE -----
+	UNIO_TEST_CHECK(!unio_eeprom_read((UNIO_EEPROM_SIZE - 1), &unio_test_read_data[0], 2));
+	UNIO_TEST_CHECK(!unio_eeprom_write((UNIO_EEPROM_SIZE - 1), &unio_test_data[0], 2));
+
+	UNIO_TEST_CHECK(unio_sim_stats.bus_errors == 0);
+}
+
+
+
+//****************************************
+//****************************************
+//********** BULK WRITE REWRITE **********
+//****************************************
+//****************************************
+//A bulk write rewrites only the pages that fail its verify read
+void unio_test_bulk_rewrite (void)
+{
+	uint16_t count;
+	UNIO_BULK_WRITE_RESULT result;
+
+	unio_test_name = "bulk_rewrite";
+	unio_test_power_on(500);
+
+	for (count = 0; count < UNIO_EEPROM_SIZE; count++)
+		unio_test_model[count] = (uint8_t)((count * 7) + 1);
+
+	unio_test_hook_pages[0] = 2;
+	unio_test_hook_pages[1] = 5;
+	unio_test_hook_write_cycles = unio_sim_stats.write_cycles + (UNIO_EEPROM_SIZE / UNIO_EEPROM_PAGE_SIZE);		//(After the last page is written)
+	unio_sim_disable_int_hook = unio_test_corrupt_pages;
+
+	UNIO_TEST_CHECK(unio_eeprom_write_bulk(0x0000, &unio_test_model[0], UNIO_EEPROM_SIZE, &result));
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+#ifndef UNIO_USE_IRQ_ENGINE
+	UNIO_TEST_CHECK(unio_test_hook_write_cycles == UNIO_TEST_NO_HOOK);				//(The IRQ engine's reads don't use DISABLE_INT)
+	UNIO_TEST_CHECK(result.pages_written == ((UNIO_EEPROM_SIZE / UNIO_EEPROM_PAGE_SIZE) + 2));
+#else
+	UNIO_TEST_CHECK(result.pages_written >= (UNIO_EEPROM_SIZE / UNIO_EEPROM_PAGE_SIZE));
+#endif
+	unio_sim_disable_int_hook = 0;
+
+	//----- PARTIAL FIRST AND LAST PAGES -----
+	for (count = 0; count < UNIO_EEPROM_SIZE; count++)
+		unio_test_data[count] = unio_test_model[count] ^ 0x5a;
+	UNIO_TEST_CHECK(unio_eeprom_write_bulk(0x0003, &unio_test_data[3], 120, &result));
+	memcpy(&unio_test_model[3], &unio_test_data[3], 120);
+	UNIO_TEST_CHECK(result.pages_written == 8);
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+
+	//----- PROTECTED UPPER QUARTER -----
+	for (count = 0; count < UNIO_EEPROM_SIZE; count++)
+		unio_test_data[count] = unio_test_model[count] ^ 0xff;
+	UNIO_TEST_CHECK(unio_eeprom_write_protect(UNIO_EEPROM_PROTECT_UPPER_QUARTER));
+	UNIO_TEST_CHECK(!unio_eeprom_write_bulk(0x0000, &unio_test_data[0], UNIO_EEPROM_SIZE, &result));
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_data[0], ((UNIO_EEPROM_SIZE * 3) / 4)) == 0);
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[((UNIO_EEPROM_SIZE * 3) / 4)], &unio_test_model[((UNIO_EEPROM_SIZE * 3) / 4)], (UNIO_EEPROM_SIZE / 4)) == 0);
+	UNIO_TEST_CHECK(unio_eeprom_write_protect(UNIO_EEPROM_PROTECT_NONE));
+}
+
+
+//unio_sim_disable_int_hook - corrupts a byte in each of unio_test_hook_pages once the device has done unio_test_hook_write_cycles write
+//cycles, i.e. between writing a page and reading it back
+void unio_test_corrupt_pages (void)
+{
+	if (unio_sim_stats.write_cycles != unio_test_hook_write_cycles)
+		return;
+
+	unio_sim_device.memory[(unio_test_hook_pages[0] * UNIO_EEPROM_PAGE_SIZE) + 5] ^= 0x10;
+	unio_sim_device.memory[(unio_test_hook_pages[1] * UNIO_EEPROM_PAGE_SIZE) + 5] ^= 0x01;
+	unio_test_device_changed();
+	unio_test_hook_write_cycles = UNIO_TEST_NO_HOOK;
+}
+
+
+
+//*********************************
+//*********************************
+//********** IRQ ENGINE **********
+//*********************************
+//*********************************
+//UNIO_USE_IRQ_ENGINE - transactions queued with unio_irq_submit() run from the timer interrupt, each completes once with its callback
+void unio_test_irq_engine (void)
+{
+#ifdef UNIO_USE_IRQ_ENGINE
+	static UNIO_TRANSACTION write_enable;
+	static UNIO_TRANSACTION write;
+	static UNIO_TRANSACTION read;
+	static UNIO_TRANSACTION status;
+	uint8_t count;
+	uint8_t status_value = UNIO_EEPROM_STATUS_WIP;
+	uint16_t polls;
+
+	unio_test_name = "irq_engine";
+	unio_test_power_on(UNIO_EEPROM_TIMER_QUARTER_PERIOD);
+	unio_test_callbacks = 0;
+
+	for (count = 0; count < UNIO_EEPROM_PAGE_SIZE; count++)
+		unio_test_data[count] = (uint8_t)(0x80 + count);
+
+	//----- WREN AND WRITE QUEUED TOGETHER -----
+	unio_test_irq_load(&write_enable, 0x96, 0, 0x0000);
+	unio_test_irq_load(&write, 0x6c, 1, 0x0030);
+	write.tx_data = &unio_test_data[0];
+	write.tx_length = UNIO_EEPROM_PAGE_SIZE;
+	UNIO_TEST_CHECK(unio_irq_submit(&write_enable));
+	UNIO_TEST_CHECK(unio_irq_submit(&write));
+	UNIO_TEST_CHECK(unio_irq_poll(&write_enable) == UNIO_IRQ_BUSY);
+	UNIO_TEST_CHECK(unio_irq_poll(&write) == UNIO_IRQ_BUSY);
+
+	UNIO_TEST_CHECK(!unio_irq_submit(&write_enable));						//Already in progress
+	UNIO_TEST_CHECK(!unio_irq_submit(&write));								//Already queued
+	UNIO_TEST_CHECK(unio_irq_poll(&write) == UNIO_IRQ_BUSY);
+
+	while (unio_irq_poll(&write) == UNIO_IRQ_BUSY)
+		unio_sim_idle_wait();
+	UNIO_TEST_CHECK(unio_irq_poll(&write_enable) == UNIO_IRQ_DONE);
+	UNIO_TEST_CHECK(unio_irq_poll(&write) == UNIO_IRQ_DONE);
+	UNIO_TEST_CHECK(unio_test_callbacks == 2);
+	UNIO_TEST_CHECK(unio_test_callback_status[0] == UNIO_IRQ_DONE);
+	UNIO_TEST_CHECK(unio_test_callback_status[1] == UNIO_IRQ_DONE);
+
+	//----- READ DURING THE WRITE CYCLE FAILS (ONLY RDSR IS ACCEPTED) -----
+	unio_test_irq_load(&read, 0x03, 1, 0x0030);
+	read.rx_data = &unio_test_read_data[0];
+	read.rx_length = UNIO_EEPROM_PAGE_SIZE;
+	UNIO_TEST_CHECK(unio_irq_submit(&read));
+	while (unio_irq_poll(&read) == UNIO_IRQ_BUSY)
+		unio_sim_idle_wait();
+	UNIO_TEST_CHECK(unio_irq_poll(&read) == UNIO_IRQ_FAILED);
+	UNIO_TEST_CHECK(unio_test_callbacks == 3);
+	UNIO_TEST_CHECK(unio_test_callback_status[2] == UNIO_IRQ_FAILED);
+
+	//----- RDSR UNTIL THE WRITE CYCLE IS COMPLETE -----
+	for (polls = 0; (polls < 1000) && (status_value & UNIO_EEPROM_STATUS_WIP); polls++)
+	{
+		unio_test_irq_load(&status, 0x05, 0, 0x0000);
+		status.rx_data = &status_value;
+		status.rx_length = 1;
+		status.callback = 0;
+		UNIO_TEST_CHECK(unio_irq_submit(&status));
+		while (unio_irq_poll(&status) == UNIO_IRQ_BUSY)
+			unio_sim_idle_wait();
+	}
+	UNIO_TEST_CHECK(!(status_value & UNIO_EEPROM_STATUS_WIP));
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0x0030], &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == 0);
+
+	//----- READ THE PAGE BACK (THE SAME TRANSACTION MAY BE SUBMITTED AGAIN ONCE COMPLETE) -----
+	memset(&unio_test_read_data[0], 0, UNIO_EEPROM_PAGE_SIZE);
+	unio_test_callbacks = 0;
+	UNIO_TEST_CHECK(unio_irq_submit(&read));
+	while (unio_irq_poll(&read) == UNIO_IRQ_BUSY)
+		unio_sim_idle_wait();
+	UNIO_TEST_CHECK(unio_irq_poll(&read) == UNIO_IRQ_DONE);
+	UNIO_TEST_CHECK(read.rx_done == UNIO_EEPROM_PAGE_SIZE);
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == 0);
+	UNIO_TEST_CHECK(unio_test_callbacks == 1);
+	UNIO_TEST_CHECK(unio_test_callback_status[0] == UNIO_IRQ_DONE);
+
+	//----- A LATER TICK DOESN'T CALL BACK AGAIN -----
+	for (count = 0; count < 100; count++)
+		unio_sim_idle_wait();
+	UNIO_TEST_CHECK(unio_test_callbacks == 1);
+	UNIO_TEST_CHECK(unio_sim_stats.bus_errors == 1);					//(Just the READ during the write cycle)
+#endif
+}
+
+
+#ifdef UNIO_USE_IRQ_ENGINE
+//Setup a transaction with no data bytes, with unio_test_irq_callback() as its callback
+void unio_test_irq_load (UNIO_TRANSACTION *transaction, uint8_t command, uint8_t send_address, uint16_t address)
+{
+	memset(transaction, 0, sizeof(UNIO_TRANSACTION));
+	transaction->command = command;
+	transaction->send_address = send_address;
+	transaction->address = address;
+	transaction->callback = unio_test_irq_callback;
+}
+
+
+//Records the status of each completed transaction
+void unio_test_irq_callback (UNIO_TRANSACTION *transaction)
+{
+	if (unio_test_callbacks < sizeof(unio_test_callback_status))
+		unio_test_callback_status[unio_test_callbacks] = (uint8_t)transaction->status;
+	unio_test_callbacks++;
+}
+#endif
+
+
+
+//*********************************
+//*********************************
+//********** WRITE START **********
+//*********************************
+//*********************************
+//unio_eeprom_write_start() returns with the write cycle still in progress, unio_eeprom_is_write_complete() then sees it end.  With
+//unio_int_off_budget_us set interrupts are let in between WREN and WRITE, and time passing there doesn't lose the write.
+void unio_test_write_start (void)
+{
+	uint8_t count;
+	uint8_t gap;
+	uint16_t polls;
+
+	unio_test_name = "write_start";
+
+	for (gap = 0; gap < 2; gap++)
+	{
+		unio_test_power_on(UNIO_EEPROM_TIMER_QUARTER_PERIOD);
+		for (count = 0; count < UNIO_EEPROM_PAGE_SIZE; count++)
+			unio_test_data[count] = (uint8_t)((count * 29) + 5 + gap);
+		unio_test_gap_taken = 0;
+		unio_sim_disable_int_hook = unio_test_interrupt_gap;
+		if (gap)
+			unio_int_off_budget_us = 60000;					//(Longer than any one transaction, so only the WREN / WRITE gap is added)
+
+		UNIO_TEST_CHECK(unio_eeprom_write_start(0x0040, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE));
+		unio_sim_disable_int_hook = 0;
+#ifndef UNIO_USE_IRQ_ENGINE
+		UNIO_TEST_CHECK(unio_test_gap_taken == gap);		//WREN and WRITE in one interrupt disabled period without a budget
+#endif
+		UNIO_TEST_CHECK(unio_sim_stats.write_cycles == 1);
+
+		//----- BUSY, THEN COMPLETE -----
+		UNIO_TEST_CHECK(!unio_eeprom_is_write_complete());
+		for (polls = 1; (polls < 1000) && (!unio_eeprom_is_write_complete()); polls++)
+			unio_sim_idle_wait();
+		UNIO_TEST_CHECK(polls < 1000);
+
+		//----- READ BACK -----
+		UNIO_TEST_CHECK(unio_eeprom_read(0x0040, &unio_test_read_data[0], UNIO_EEPROM_PAGE_SIZE));
+		UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == 0);
+		UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0x0040], &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == 0);
+		UNIO_TEST_CHECK(unio_sim_stats.bus_errors == 0);
+	}
+
+	//----- NOTHING SENT FOR DATA CROSSING A PAGE BOUNDARY -----
+	UNIO_TEST_CHECK(!unio_eeprom_write_start((0x0040 + 1), &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE));
+	UNIO_TEST_CHECK(unio_sim_stats.write_cycles == 1);
+}
+
+
+//unio_sim_disable_int_hook for unio_test_write_start() - interrupts being disabled again after WREN (WEL set, no write cycle yet)
+//lets 2mS pass as if another interrupt had run in the gap
+void unio_test_interrupt_gap (void)
+{
+	uint64_t until;
+
+	if ((unio_test_gap_taken) || (!(unio_sim_device.status & UNIO_EEPROM_STATUS_WEL)) || (unio_sim_stats.write_cycles))
+		return;
+	unio_test_gap_taken = 1;
+
+	until = unio_sim_stats.elapsed_ns + 2000000;
+	while (unio_sim_stats.elapsed_ns < until)
+		unio_sim_idle_wait();
+}
+
+
+
+//*********************************************
+//*********************************************
+//********** LEARNT WRITE CYCLE TIME **********
+//*********************************************
+//*********************************************
+//unio_wait_for_write_complete() learns the device's write cycle time, so after the first few writes each needs only one or two WIP polls.
+//A part that gets slower (e.g. hotter) is relearnt.
+void unio_test_write_cycle_learning (void)
+{
+	uint8_t count;
+	uint8_t part;
+	uint32_t polls;
+	uint32_t first_polls;
+	uint32_t expected;
+	UNIO_STATS stats;
+	static const uint32_t write_cycles_ns[] = {3000000, 4500000};
+
+	unio_test_name = "write_cycle_learning";
+	unio_test_power_on(50);
+	unio_verify_policy = UNIO_VERIFY_NONE;
+
+	for (part = 0; part < (sizeof(write_cycles_ns) / sizeof(write_cycles_ns[0])); part++)
+	{
+		unio_sim_device.write_cycle_ns = write_cycles_ns[part];
+		first_polls = 0;
+
+		for (count = 0; count < 12; count++)
+		{
+			memset(&unio_test_data[0], (count + (part << 4)), UNIO_EEPROM_PAGE_SIZE);
+			unio_stats_read(&stats);
+			polls = stats.wip_polls;
+			UNIO_TEST_CHECK(unio_eeprom_write(0x0010, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE));
+			unio_stats_read(&stats);
+			polls = stats.wip_polls - polls;
+			if (count == 0)
+				first_polls = polls;
+		}
+		UNIO_TEST_CHECK(polls <= 2);								//Settled
+		UNIO_TEST_CHECK(polls < first_polls);
+
+		//Learnt value is a little under the simulated time (it is timed to the start of the poll, and the wait adds a margin)
+		expected = UNIO_EEPROM_US_TO_TICKS(write_cycles_ns[part] / 1000);
+		UNIO_TEST_CHECK(unio_write_cycle_ticks[unio_write_cycle_band] >= (expected - (expected >> 2)));
+		UNIO_TEST_CHECK(unio_write_cycle_ticks[unio_write_cycle_band] <= (expected + (expected >> 3)));
+	}
+
+	unio_stats_read(&stats);
+	UNIO_TEST_CHECK(stats.wip_timeouts == 0);
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0x0010], &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == 0);
+}
+
+
+
+//*********************************
+//*********************************
+//********** WRITE CACHE **********
+//*********************************
+//*********************************
+//mem-11lcxxx-cache.c - random writes and reads against the RAM model
+void unio_test_write_cache (void)
+{
+	uint16_t count;
+	uint16_t address;
+	uint8_t length;
+	uint8_t index;
+	uint8_t bad = 0;
+	uint16_t page_writes;
+	uint32_t write_cycles;
+
+	unio_test_name = "write_cache";
+	unio_test_power_on(500);
+
+	UNIO_TEST_CHECK(unio_cache_load());
+	UNIO_TEST_CHECK(unio_cache_dirty_count() == 0);
+
+	for (count = 0; count < UNIO_TEST_RANDOM_OPS; count++)
+	{
+		address = unio_test_random() % UNIO_CACHE_SIZE;
+		length = 1 + (unio_test_random() % 24);
+		if ((address + length) > UNIO_CACHE_SIZE)
+			length = (uint8_t)(UNIO_CACHE_SIZE - address);
+
+		if (unio_test_random() & 0x01)
+		{
+			for (index = 0; index < length; index++)
+				unio_test_data[index] = unio_test_random();
+			if (!unio_cache_write(address, &unio_test_data[0], length))
+				bad++;
+			memcpy(&unio_test_model[address], &unio_test_data[0], length);
+		}
+		else
+		{
+			if (!unio_cache_read(address, &unio_test_read_data[0], length))
+				bad++;
+			if (memcmp(&unio_test_read_data[0], &unio_test_model[address], length) != 0)
+				bad++;
+		}
+
+		if ((unio_test_random() & 0x0f) == 0)
+		{
+			unio_cache_flush_timer = 0;
+			unio_cache_process();
+		}
+	}
+	UNIO_TEST_CHECK(bad == 0);
+	UNIO_TEST_CHECK(unio_cache_flush());
+	UNIO_TEST_CHECK(unio_cache_dirty_count() == 0);
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_CACHE_SIZE) == 0);
+
+	//----- DIRTY PAGE COUNT -----
+	memset(&unio_test_data[0], 0xa5, 4);
+	UNIO_TEST_CHECK(unio_cache_write(0x0010, &unio_test_data[0], 4));
+	UNIO_TEST_CHECK(unio_cache_write(0x0014, &unio_test_data[0], 4));
+	UNIO_TEST_CHECK(unio_cache_write(0x001e, &unio_test_data[0], 4));				//(Crosses into the next page)
+	UNIO_TEST_CHECK(unio_cache_dirty_count() == 2);
+
+	page_writes = unio_cache_page_writes;
+	write_cycles = unio_sim_stats.write_cycles;
+	UNIO_TEST_CHECK(unio_cache_flush());
+	UNIO_TEST_CHECK(unio_cache_dirty_count() == 0);
+	UNIO_TEST_CHECK(unio_cache_page_writes == (page_writes + 2));
+	UNIO_TEST_CHECK(unio_sim_stats.write_cycles == (write_cycles + 2));
+
+	//----- PAGE CHANGED BACK TO WHAT THE DEVICE HOLDS (unio_cache_process() page write) -----
+	UNIO_TEST_CHECK(unio_cache_read(0x0040, &unio_test_read_data[0], 4));
+	memset(&unio_test_data[0], 0x3c, 4);
+	UNIO_TEST_CHECK(unio_cache_write(0x0040, &unio_test_data[0], 4));
+	UNIO_TEST_CHECK(unio_cache_write(0x0040, &unio_test_read_data[0], 4));
+	UNIO_TEST_CHECK(unio_cache_dirty_count() == 1);
+
+	page_writes = unio_cache_page_writes;
+	write_cycles = unio_sim_stats.write_cycles;
+	unio_cache_flush_timer = 0;
+	unio_cache_process();
+	UNIO_TEST_CHECK(unio_cache_dirty_count() == 0);
+#ifdef UNIO_WRITE_SKIP_UNCHANGED
+	UNIO_TEST_CHECK(unio_cache_page_writes == page_writes);						//(Skipped, no write cycle)
+	UNIO_TEST_CHECK(unio_sim_stats.write_cycles == write_cycles);
+#else
+	UNIO_TEST_CHECK(unio_cache_page_writes == (page_writes + 1));
+#endif
+
+	//----- unio_eeprom_write_report() -----
+	memset(&unio_test_data[0], 0x96, UNIO_EEPROM_PAGE_SIZE);
+	UNIO_TEST_CHECK(unio_eeprom_write_report(0x0050, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == UNIO_WRITE_DONE);
+#ifdef UNIO_WRITE_SKIP_UNCHANGED
+	UNIO_TEST_CHECK(unio_eeprom_write_report(0x0050, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == UNIO_WRITE_SKIPPED);
+#else
+	UNIO_TEST_CHECK(unio_eeprom_write_report(0x0050, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == UNIO_WRITE_DONE);
+#endif
+	UNIO_TEST_CHECK(unio_eeprom_write_report(0x0051, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == UNIO_WRITE_FAILED);		//(Crosses a page boundary)
+}
+
+
+
+//************************
+//************************
+//********** KV **********
+//************************
+//************************
+//mem-11lcxxx-kv.c - values survive remounting and log wrap round (compaction)
+void unio_test_kv (void)
+{
+	uint32_t value;
+	uint32_t read_value;
+	uint16_t count;
+	uint8_t bad = 0;
+	static const uint8_t cold_value[] = "cold-value";
+	uint8_t read_cold[sizeof(cold_value)];
+
+	unio_test_name = "kv";
+	unio_test_power_on(500);
+
+	UNIO_TEST_CHECK(unio_kv_mount());
+	UNIO_TEST_CHECK(unio_kv_put(3, (uint8_t*)&cold_value[0], sizeof(cold_value)));
+	for (value = 1; value <= 100; value++)
+	{
+		if (!unio_kv_put(0, (uint8_t*)&value, sizeof(value)))
+			bad++;
+	}
+	UNIO_TEST_CHECK(bad == 0);
+
+	UNIO_TEST_CHECK(unio_kv_mount());
+	read_value = 0;
+	UNIO_TEST_CHECK(unio_kv_get(0, (uint8_t*)&read_value, sizeof(read_value)) == sizeof(read_value));
+	UNIO_TEST_CHECK(read_value == 100);
+	memset(&read_cold[0], 0, sizeof(read_cold));
+	UNIO_TEST_CHECK(unio_kv_get(3, &read_cold[0], sizeof(read_cold)) == sizeof(cold_value));
+	UNIO_TEST_CHECK(memcmp(&read_cold[0], &cold_value[0], sizeof(cold_value)) == 0);
+	UNIO_TEST_CHECK(unio_kv_get(1, &read_cold[0], sizeof(read_cold)) == 0);
+
+	//----- TORN WRITE -----
+	for (count = 0; count < (UNIO_KV_PAGES * UNIO_EEPROM_PAGE_SIZE); count += UNIO_EEPROM_PAGE_SIZE)		//Find the newest record of key 0 and corrupt it
+	{
+		if ((unio_sim_device.memory[count] == 0) && (unio_sim_device.memory[count + 4] == 100))
+			unio_sim_device.memory[count + 4] ^= 0x80;
+	}
+	unio_test_device_changed();
+	UNIO_TEST_CHECK(unio_kv_mount());
+	read_value = 0;
+	UNIO_TEST_CHECK(unio_kv_get(0, (uint8_t*)&read_value, sizeof(read_value)) == sizeof(read_value));
+	UNIO_TEST_CHECK(read_value == 99);
+
+	//----- ZERO FILLED PAGE IS NOT A RECORD -----
+	unio_test_power_on(500);
+	memset(&unio_sim_device.memory[(UNIO_KV_START_PAGE + 2) * UNIO_EEPROM_PAGE_SIZE], 0x00, UNIO_EEPROM_PAGE_SIZE);
+	unio_test_device_changed();
+	UNIO_TEST_CHECK(unio_kv_mount());
+	UNIO_TEST_CHECK(unio_kv_get(0, (uint8_t*)&read_value, sizeof(read_value)) == 0);
+	value = 7;
+	UNIO_TEST_CHECK(unio_kv_put(0, (uint8_t*)&value, sizeof(value)));
+	UNIO_TEST_CHECK(unio_sim_device.memory[(UNIO_KV_START_PAGE * UNIO_EEPROM_PAGE_SIZE) + 4] == 7);		//(Empty store, so the log starts at its first page)
+	UNIO_TEST_CHECK(unio_kv_mount());
+	read_value = 0;
+	UNIO_TEST_CHECK(unio_kv_get(0, (uint8_t*)&read_value, sizeof(read_value)) == sizeof(read_value));
+	UNIO_TEST_CHECK(read_value == 7);
+}
+
+
+
+//***************************
+//***************************
+//********** MULTI **********
+//***************************
+//***************************
+//mem-11lcxxx-multi.c - all buses written and read together, a missing device only fails its own bus
+void unio_test_multi (void)
+{
+	uint8_t bus;
+	uint8_t count;
+	uint8_t *bus_data[UNIO_MULTI_BUSES];
+	uint32_t histogram_count = 0;
+	UNIO_STATS stats;
+	static uint8_t bus_image[UNIO_MULTI_BUSES][UNIO_EEPROM_PAGE_SIZE * 2];
+
+	unio_test_name = "multi";
+	unio_sim_reset();
+	unio_set_bus_speed(UNIO_EEPROM_TIMER_QUARTER_PERIOD);
+	unio_sim_device_count = UNIO_MULTI_BUSES;
+	unio_multi_init();
+	unio_stats_reset();
+
+	for (count = 0; count < UNIO_EEPROM_PAGE_SIZE; count++)
+		unio_test_data[count] = (uint8_t)(0xa0 + count);
+	for (bus = 0; bus < UNIO_MULTI_BUSES; bus++)
+		bus_data[bus] = &unio_test_data[0];
+	UNIO_TEST_CHECK(unio_multi_write(UNIO_MULTI_ALL_BUSES, 0x0020, &bus_data[0], UNIO_EEPROM_PAGE_SIZE) == UNIO_MULTI_ALL_BUSES);
+
+	//----- COUNTED IN THE DRIVER'S STATS -----
+	unio_stats_read(&stats);
+	UNIO_TEST_CHECK(stats.writes == 1);
+	UNIO_TEST_CHECK(stats.write_retries == 0);
+	UNIO_TEST_CHECK(stats.wip_polls > 0);
+	UNIO_TEST_CHECK(stats.int_off_count == (stats.wip_polls + 3));			//(WREN, WRITE, RDSR polls and the read back)
+	for (count = 0; count < UNIO_STATS_INT_OFF_BINS; count++)
+		histogram_count += stats.int_off_histogram[count];
+	UNIO_TEST_CHECK(histogram_count == stats.int_off_count);
+	UNIO_TEST_CHECK(stats.int_off_max_us > 0);
+
+	for (bus = 0; bus < UNIO_MULTI_BUSES; bus++)
+		bus_data[bus] = &bus_image[bus][0];
+	UNIO_TEST_CHECK(unio_multi_read(UNIO_MULTI_ALL_BUSES, 0x0018, &bus_data[0], (UNIO_EEPROM_PAGE_SIZE * 2)) == UNIO_MULTI_ALL_BUSES);
+	for (bus = 0; bus < UNIO_MULTI_BUSES; bus++)
+	{
+		UNIO_TEST_CHECK(memcmp(&bus_image[bus][8], &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == 0);
+		UNIO_TEST_CHECK(memcmp(&unio_sim_devices[bus].memory[0x0020], &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == 0);
+	}
+
+	unio_sim_device_count = UNIO_MULTI_BUSES - 2;
+	UNIO_TEST_CHECK(unio_multi_read(UNIO_MULTI_ALL_BUSES, 0x0018, &bus_data[0], (UNIO_EEPROM_PAGE_SIZE * 2)) == (UNIO_MULTI_ALL_BUSES >> 2));
+
+	//----- WIP POLLING GIVES UP AFTER THE DRIVER'S WRITE CYCLE TIME LIMIT -----
+	unio_sim_device_count = UNIO_MULTI_BUSES;
+	unio_multi_init();
+	unio_sim_devices[3].write_cycle_ns = 100000000;					//(Far longer than UNIO_EEPROM_WRITE_CYCLE_US)
+	unio_stats_reset();
+	for (bus = 0; bus < UNIO_MULTI_BUSES; bus++)
+		bus_data[bus] = &unio_test_data[0];
+	UNIO_TEST_CHECK(unio_multi_write(UNIO_MULTI_ALL_BUSES, 0x0030, &bus_data[0], UNIO_EEPROM_PAGE_SIZE) == (UNIO_MULTI_ALL_BUSES & ~0x08));
+	unio_stats_read(&stats);
+	UNIO_TEST_CHECK(stats.wip_timeouts > 0);
+	UNIO_TEST_CHECK(stats.failures == 1);
+	UNIO_TEST_CHECK(stats.wip_polls < (UNIO_EEPROM_US_TO_TICKS(UNIO_EEPROM_WRITE_CYCLE_US * 2 * 3) / 40));		//(An RDSR is more than 40 quarter bit periods)
+
+	unio_sim_device_count = 1;
+	unio_eeprom_init();
+}
+
+
+
+//***********************************
+//***********************************
+//********** TIMER SHARING **********
+//***********************************
+//***********************************
+//unio_timer_other_register() - the other user keeps getting its ticks at its own period while a write cycle runs, UNI/O only borrowing
+//the timer for each transaction
+void unio_test_timer_sharing (void)
+{
+	uint8_t count;
+	uint8_t waits;
+	uint16_t polls = 0;
+	uint64_t elapsed_ns;
+	uint64_t bus_active_ns;
+	uint32_t expected;
+
+	unio_test_name = "timer_sharing";
+	unio_test_power_on(50);
+	unio_test_other_ticks = 0;
+	unio_test_other_bad = 0;
+	unio_test_other_last_ns = unio_sim_stats.elapsed_ns;
+
+	unio_timer_other_register(UNIO_TEST_OTHER_PERIOD, unio_test_other_isr);
+	for (waits = 0; waits < 10; waits++)
+		unio_sim_idle_wait();
+	UNIO_TEST_CHECK(unio_test_other_ticks == 10);
+
+	//----- WRITE CYCLE WITH STATUS POLLS IN BETWEEN OTHER TICKS -----
+	for (count = 0; count < UNIO_EEPROM_PAGE_SIZE; count++)
+		unio_test_data[count] = (uint8_t)(0x5a ^ count);
+	unio_test_other_ticks = 0;
+	elapsed_ns = unio_sim_stats.elapsed_ns;
+	bus_active_ns = unio_sim_stats.bus_active_ns;
+	UNIO_TEST_CHECK(unio_eeprom_write_start(0x0060, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE));
+	while ((polls < 1000) && (!unio_eeprom_is_write_complete()))
+	{
+		polls++;
+		for (waits = 0; waits < 5; waits++)
+			unio_sim_idle_wait();
+	}
+	UNIO_TEST_CHECK(polls > 0);
+	UNIO_TEST_CHECK(polls < 1000);
+
+	//Every idle wait was an other tick, and there were no more than fit in the time the bus wasn't in use
+	expected = (uint32_t)(((unio_sim_stats.elapsed_ns - elapsed_ns) - (unio_sim_stats.bus_active_ns - bus_active_ns)) / ((uint64_t)UNIO_TEST_OTHER_PERIOD * UNIO_SIM_TIMER_COUNT_NS));
+	UNIO_TEST_CHECK(unio_test_other_ticks >= (polls * 5));
+	UNIO_TEST_CHECK(unio_test_other_ticks <= (expected + 1));
+	UNIO_TEST_CHECK(unio_test_other_bad == 0);
+
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0060, &unio_test_read_data[0], UNIO_EEPROM_PAGE_SIZE));
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == 0);
+
+	//----- STOP SHARING -----
+	unio_timer_other_register(0, 0);
+	unio_test_other_ticks = 0;
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0060, &unio_test_read_data[0], UNIO_EEPROM_PAGE_SIZE));
+	for (waits = 0; waits < 10; waits++)
+		unio_sim_idle_wait();
+	UNIO_TEST_CHECK(unio_test_other_ticks == 0);
+}
+
+
+//The other timer user's interrupt handler (unio_timer_other_register())
+void unio_test_other_isr (void)
+{
+	unio_test_other_ticks++;
+	if ((unio_sim_stats.elapsed_ns - unio_test_other_last_ns) < ((uint64_t)UNIO_TEST_OTHER_PERIOD * UNIO_SIM_TIMER_COUNT_NS))
+		unio_test_other_bad++;						//Faster than its period (called while UNI/O had the timer)
+	unio_test_other_last_ns = unio_sim_stats.elapsed_ns;
+}
+
+
+
+//********************************
+//********************************
+//********** CLOCK SKEW **********
+//********************************
+//********************************
+//Reads with the device's clock running fast and slow.  Up to UNIO_TEST_SKEW_LIMIT_PPM the data is read correctly first time, well
+//beyond it the read fails cleanly (decode errors counted, data zeroed) and the bus still works once the skew is gone.  The edge decoder
+//(unio_input_byte_edges()) tracks the device's clock, so its limit is over twice that of fixed point sampling.
+void unio_test_clock_skew (void)
+{
+	uint8_t index;
+	uint8_t count;
+	UNIO_STATS stats;
+	static const int32_t skews_ppm[] = {0, (UNIO_TEST_SKEW_LIMIT_PPM / 2), -(UNIO_TEST_SKEW_LIMIT_PPM / 2), UNIO_TEST_SKEW_LIMIT_PPM, -UNIO_TEST_SKEW_LIMIT_PPM};
+
+	unio_test_name = "clock_skew";
+	unio_test_power_on(UNIO_EEPROM_TIMER_QUARTER_PERIOD);
+	for (count = 0; count < (UNIO_EEPROM_PAGE_SIZE * 2); count++)
+		unio_sim_device.memory[0x0020 + count] = (uint8_t)((count * 73) + 1);
+
+	for (index = 0; index < (sizeof(skews_ppm) / sizeof(skews_ppm[0])); index++)
+	{
+		unio_sim_device.clock_skew_ppm = skews_ppm[index];
+		unio_test_device_changed();						//(Read from the device each time)
+		unio_stats_reset();
+		memset(&unio_test_read_data[0], 0, (UNIO_EEPROM_PAGE_SIZE * 2));
+		UNIO_TEST_CHECK(unio_eeprom_read(0x0020, &unio_test_read_data[0], (UNIO_EEPROM_PAGE_SIZE * 2)));
+		UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_sim_device.memory[0x0020], (UNIO_EEPROM_PAGE_SIZE * 2)) == 0);
+		unio_stats_read(&stats);
+		UNIO_TEST_CHECK(stats.decode_errors == 0);
+		UNIO_TEST_CHECK(stats.read_retries == 0);
+	}
+
+	//----- BEYOND THE LIMIT -----
+	unio_sim_device.clock_skew_ppm = UNIO_TEST_SKEW_LIMIT_PPM * 4;
+	unio_test_device_changed();
+	unio_stats_reset();
+	memset(&unio_test_read_data[0], 0x55, (UNIO_EEPROM_PAGE_SIZE * 2));
+	UNIO_TEST_CHECK(!unio_eeprom_read(0x0020, &unio_test_read_data[0], (UNIO_EEPROM_PAGE_SIZE * 2)));
+	for (count = 0; (count < (UNIO_EEPROM_PAGE_SIZE * 2)) && (unio_test_read_data[count] == 0x00); count++)
+		;
+	UNIO_TEST_CHECK(count == (UNIO_EEPROM_PAGE_SIZE * 2));				//(Failed reads return 0x00)
+	unio_stats_read(&stats);
+	UNIO_TEST_CHECK(stats.decode_errors > 0);
+	UNIO_TEST_CHECK(stats.failures == 1);
+
+	unio_sim_device.clock_skew_ppm = 0;
+	unio_standby_pulse();
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0020, &unio_test_read_data[0], (UNIO_EEPROM_PAGE_SIZE * 2)));
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_sim_device.memory[0x0020], (UNIO_EEPROM_PAGE_SIZE * 2)) == 0);
+}
+
+
+
+//*********************************
+//*********************************
+//********** CALIBRATION **********
+//*********************************
+//*********************************
+//unio_calibrate_bus_speed() picks the fastest speed the device follows (plus its margin), and unio_speed_feedback() slows the bus by a
+//step when reads start failing
+void unio_test_calibration (void)
+{
+	uint16_t period;
+	uint16_t fastest;
+
+	unio_test_name = "calibration";
+	unio_test_power_on(UNIO_EEPROM_TIMER_QUARTER_PERIOD);
+	unio_sim_device.min_quarter_ns = (uint32_t)UNIO_TEST_MIN_QUARTER_PERIOD * UNIO_SIM_TIMER_COUNT_NS;
+
+	//The fastest step of the calibration sequence the device can follow
+	fastest = UNIO_EEPROM_TIMER_QUARTER_PERIOD;
+	while (1)
+	{
+		period = fastest - (uint16_t)(((uint32_t)fastest * UNIO_SPEED_STEP_PERCENT) / 100);
+		if (period < UNIO_TEST_MIN_QUARTER_PERIOD)
+			break;
+		fastest = period;
+	}
+
+	UNIO_TEST_CHECK(unio_calibrate_bus_speed());
+	UNIO_TEST_CHECK(unio_quarter_period == (fastest + (uint16_t)(((uint32_t)fastest * UNIO_CALIBRATE_MARGIN_PERCENT) / 100)));
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0000, &unio_test_read_data[0], UNIO_EEPROM_SIZE));
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_sim_device.memory[0], UNIO_EEPROM_SIZE) == 0);
+
+	//----- DEVICE GETS SLOWER - READS FAIL UNTIL THE FEEDBACK SLOWS THE BUS -----
+	period = unio_quarter_period;
+	unio_sim_device.min_quarter_ns = ((uint32_t)period * UNIO_SIM_TIMER_COUNT_NS * 110) / 100;		//(Less than one step slower)
+	unio_test_device_changed();
+	UNIO_TEST_CHECK(!unio_eeprom_read(0x0000, &unio_test_read_data[0], UNIO_EEPROM_PAGE_SIZE));		//(Each of its attempts fails)
+	UNIO_TEST_CHECK(unio_quarter_period == (period + (uint16_t)(((uint32_t)period * UNIO_SPEED_STEP_PERCENT) / 100) + 1));
+	unio_standby_pulse();
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0000, &unio_test_read_data[0], UNIO_EEPROM_PAGE_SIZE));
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_sim_device.memory[0], UNIO_EEPROM_PAGE_SIZE) == 0);
+
+	//----- NEVER SLOWER THAN UNIO_EEPROM_TIMER_QUARTER_PERIOD -----
+	unio_sim_device.min_quarter_ns = 0;
+	unio_set_bus_speed(UNIO_EEPROM_TIMER_QUARTER_PERIOD);
+	unio_sim_device.min_quarter_ns = (uint32_t)(UNIO_EEPROM_TIMER_QUARTER_PERIOD + 1) * UNIO_SIM_TIMER_COUNT_NS;
+	unio_test_device_changed();
+	UNIO_TEST_CHECK(!unio_eeprom_read(0x0000, &unio_test_read_data[0], UNIO_EEPROM_PAGE_SIZE));
+	UNIO_TEST_CHECK(unio_quarter_period == UNIO_EEPROM_TIMER_QUARTER_PERIOD);
+	unio_sim_device.min_quarter_ns = 0;
+}
+
+
+
+//*************************************
+//*************************************
+//********** INT OFF BALANCE **********
+//*************************************
+//*************************************
+//Every ENABLE_INT follows a DISABLE_INT and every interrupt disabled period is counted once, including when a write fails all its retries
+void unio_test_int_off_balance (void)
+{
+	uint8_t bin;
+	uint32_t histogram_count = 0;
+	UNIO_STATS stats;
+
+	unio_test_name = "int_off_balance";
+	unio_test_power_on(UNIO_EEPROM_TIMER_QUARTER_PERIOD);
+
+	UNIO_TEST_CHECK(unio_eeprom_write_protect(UNIO_EEPROM_PROTECT_ALL));
+	memset(&unio_test_data[0], 0x12, UNIO_EEPROM_PAGE_SIZE);
+	unio_stats_reset();
+	unio_sim_reset_stats();
+	UNIO_TEST_CHECK(!unio_eeprom_write(0x0000, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE));		//(Fails its read back verify)
+
+	unio_stats_read(&stats);
+	UNIO_TEST_CHECK(stats.failures == 1);
+	UNIO_TEST_CHECK(stats.verify_errors == 3);
+#ifndef UNIO_USE_IRQ_ENGINE
+	UNIO_TEST_CHECK(stats.int_off_count > 0);				//(The IRQ engine doesn't disable interrupts)
+#endif
+	for (bin = 0; bin < UNIO_STATS_INT_OFF_BINS; bin++)
+		histogram_count += stats.int_off_histogram[bin];
+	UNIO_TEST_CHECK(histogram_count == stats.int_off_count);
+	UNIO_TEST_CHECK(unio_sim_stats.int_unmatched_enables == 0);
+
+	UNIO_TEST_CHECK(unio_eeprom_write_protect(UNIO_EEPROM_PROTECT_NONE));
+}
+
+
+
+//*************************************
+//*************************************
+//********** VERIFY POLICIES **********
+//*************************************
+//*************************************
+//Each unio_verify_policy writes the data, and reads back only as much as it should.  Deferred verify finds a byte changed after the write.
+void unio_test_verify_policies (void)
+{
+	uint8_t policy;
+	uint16_t count;
+	uint16_t failed_address;
+	uint32_t bytes_read[4];
+
+	unio_test_name = "verify_policies";
+
+	for (policy = UNIO_VERIFY_READ_BACK; policy <= UNIO_VERIFY_DEFERRED; policy++)
+	{
+		unio_test_power_on(500);
+		unio_verify_policy = policy;
+		for (count = 0; count < UNIO_EEPROM_SIZE; count++)
+			unio_test_data[count] = (uint8_t)((count * 11) + policy);
+
+		bytes_read[policy] = unio_sim_stats.bytes_read;
+		UNIO_TEST_CHECK(unio_eeprom_write_bulk(0x0005, &unio_test_data[5], 100, 0));
+		bytes_read[policy] = unio_sim_stats.bytes_read - bytes_read[policy];
+		UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[5], &unio_test_data[5], 100) == 0);
+
+		//----- SINGLE PAGE WRITES -----
+		for (count = 0; count < 3; count++)
+			UNIO_TEST_CHECK(unio_eeprom_write((0x0070 + count), &unio_test_data[count], 1));
+
+		//----- CORRUPT A BULK WRITTEN BYTE -----
+		unio_sim_device.memory[40] ^= 0x01;
+		unio_test_device_changed();
+		failed_address = 0xffff;
+		if (policy == UNIO_VERIFY_DEFERRED)
+		{
+			UNIO_TEST_CHECK(!unio_eeprom_verify_deferred(&failed_address));
+			UNIO_TEST_CHECK((failed_address <= 40) && (failed_address >= (40 - UNIO_EEPROM_PAGE_SIZE)));
+		}
+		else
+		{
+			UNIO_TEST_CHECK(unio_eeprom_verify_deferred(&failed_address));			//(Nothing stored)
+		}
+	}
+
+	//Read back reads the 100 bytes again, none and deferred don't, sampled only does every UNIO_VERIFY_SAMPLE_INTERVAL pages
+	UNIO_TEST_CHECK(bytes_read[UNIO_VERIFY_READ_BACK] >= (bytes_read[UNIO_VERIFY_NONE] + 100));
+	UNIO_TEST_CHECK(bytes_read[UNIO_VERIFY_DEFERRED] == bytes_read[UNIO_VERIFY_NONE]);
+	UNIO_TEST_CHECK(bytes_read[UNIO_VERIFY_SAMPLED] == bytes_read[UNIO_VERIFY_NONE]);
+}
+
+
+
+//****************************
+//****************************
+//********** GLITCH **********
+//****************************
+//****************************
+//A byte output with a bad Manchester bit is detected and read again
+void unio_test_glitch (void)
+{
+	uint16_t count;
+	UNIO_STATS stats;
+
+	unio_test_name = "glitch";
+	unio_test_power_on(500);
+
+	for (count = 0; count < UNIO_EEPROM_SIZE; count++)
+		unio_test_model[count] = (uint8_t)((count * 37) + 11);
+	memcpy(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_EEPROM_SIZE);
+
+	unio_sim_device.glitch_byte = unio_sim_stats.bytes_read + 100;
+	memset(&unio_test_read_data[0], 0, UNIO_EEPROM_SIZE);
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0000, &unio_test_read_data[0], UNIO_EEPROM_SIZE));
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+
+	unio_stats_read(&stats);
+	UNIO_TEST_CHECK(stats.decode_errors == 1);
+	UNIO_TEST_CHECK(stats.read_retries == 1);
+	UNIO_TEST_CHECK(stats.failures == 0);
+}
+
+
+
+//***************************************
+//***************************************
+//********** ERASE AND PROTECT **********
+//***************************************
+//***************************************
+//ERAL / SETAL change the whole array, and are refused (as are writes to the protected block) once block protection is set
+void unio_test_erase_protect (void)
+{
+	uint8_t status;
+
+	unio_test_name = "erase_protect";
+	unio_test_power_on(500);
+
+	UNIO_TEST_CHECK(unio_eeprom_erase_all());
+	memset(&unio_test_model[0], 0x00, UNIO_EEPROM_SIZE);
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+
+	UNIO_TEST_CHECK(unio_eeprom_set_all());
+	memset(&unio_test_model[0], 0xff, UNIO_EEPROM_SIZE);
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+
+	//----- UPPER HALF PROTECTED -----
+	UNIO_TEST_CHECK(unio_eeprom_write_protect(UNIO_EEPROM_PROTECT_UPPER_HALF));
+	UNIO_TEST_CHECK(unio_eeprom_read_status(&status));
+	UNIO_TEST_CHECK((status & (UNIO_EEPROM_STATUS_BP0 | UNIO_EEPROM_STATUS_BP1)) == UNIO_EEPROM_PROTECT_UPPER_HALF);
+
+	memset(&unio_test_data[0], 0x55, UNIO_EEPROM_PAGE_SIZE);
+	UNIO_TEST_CHECK(unio_eeprom_write(0x0000, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE));
+	UNIO_TEST_CHECK(!unio_eeprom_write((UNIO_EEPROM_SIZE - UNIO_EEPROM_PAGE_SIZE), &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE));
+	UNIO_TEST_CHECK(!unio_eeprom_erase_all());														//(Refused with blocks protected)
+	memset(&unio_test_model[0], 0x55, UNIO_EEPROM_PAGE_SIZE);
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+
+	UNIO_TEST_CHECK(unio_eeprom_write_protect(UNIO_EEPROM_PROTECT_NONE));
+	UNIO_TEST_CHECK(unio_eeprom_write((UNIO_EEPROM_SIZE - UNIO_EEPROM_PAGE_SIZE), &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE));
+}
+
+
+
+//***************************
+//***************************
+//********** IMAGE **********
+//***************************
+//***************************
+//mem-11lcxxx-image.c - only the pages that differ are written, and the unio_image_tool() dump, diff and sync commands on a device file
+void unio_test_image (void)
+{
+	uint16_t count;
+	UNIO_IMAGE_RESULT result;
+	char *dump_args[] = {"unio_image_tool", "-d", UNIO_TEST_DEVICE_FILE, "dump", UNIO_TEST_IMAGE_FILE};
+	char *diff_args[] = {"unio_image_tool", "-d", UNIO_TEST_DEVICE_FILE, "diff", UNIO_TEST_IMAGE_FILE};
+	char *sync_args[] = {"unio_image_tool", "-d", UNIO_TEST_DEVICE_FILE, "sync", UNIO_TEST_IMAGE_FILE};
+	char *usage_args[] = {"unio_image_tool", "sync"};
+
+	unio_test_name = "image";
+	unio_test_power_on(500);
+
+	for (count = 0; count < UNIO_EEPROM_SIZE; count++)
+		unio_test_model[count] = (uint8_t)(count ^ 0x33);
+	UNIO_TEST_CHECK(unio_image_sync(0x0000, &unio_test_model[0], UNIO_EEPROM_SIZE, &result));
+	UNIO_TEST_CHECK(result.pages_changed == (UNIO_EEPROM_SIZE / UNIO_EEPROM_PAGE_SIZE));
+
+	unio_test_model[0x0011] ^= 0xff;
+	unio_test_model[0x0052] ^= 0xff;
+	unio_test_model[0x005f] ^= 0xff;
+	UNIO_TEST_CHECK(unio_image_sync(0x0000, &unio_test_model[0], UNIO_EEPROM_SIZE, &result));
+	UNIO_TEST_CHECK(result.pages_compared == (UNIO_EEPROM_SIZE / UNIO_EEPROM_PAGE_SIZE));
+	UNIO_TEST_CHECK(result.pages_changed == 2);
+	UNIO_TEST_CHECK(result.pages_written == 2);
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+
+	UNIO_TEST_CHECK(unio_image_dump(&unio_test_read_data[0]));
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+
+	//----- TOOL DUMP -----
+	for (count = 0; count < UNIO_EEPROM_SIZE; count++)
+		unio_test_model[count] = (uint8_t)((count * 13) ^ 0xc5);
+	UNIO_TEST_CHECK(unio_test_file(UNIO_TEST_DEVICE_FILE, &unio_test_model[0], 1));
+	remove(UNIO_TEST_IMAGE_FILE);
+	UNIO_TEST_CHECK(unio_image_tool(5, dump_args) == 0);
+	UNIO_TEST_CHECK(unio_test_file(UNIO_TEST_IMAGE_FILE, &unio_test_read_data[0], 0));
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+
+	//----- TOOL DIFF -----
+	UNIO_TEST_CHECK(unio_image_tool(5, diff_args) == 0);					//(Same)
+	memcpy(&unio_test_data[0], &unio_test_model[0], UNIO_EEPROM_SIZE);
+	unio_test_data[0x0003] ^= 0x01;
+	unio_test_data[UNIO_EEPROM_SIZE - 1] ^= 0x80;
+	UNIO_TEST_CHECK(unio_test_file(UNIO_TEST_IMAGE_FILE, &unio_test_data[0], 1));
+	UNIO_TEST_CHECK(unio_image_tool(5, diff_args) == 1);					//(2 pages differ)
+	UNIO_TEST_CHECK(unio_test_file(UNIO_TEST_DEVICE_FILE, &unio_test_read_data[0], 0));
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);		//(Device file unchanged)
+
+	//----- TOOL SYNC -----
+	UNIO_TEST_CHECK(unio_image_tool(5, sync_args) == 0);
+	UNIO_TEST_CHECK(unio_sim_stats.write_cycles == 2);						//(Only the pages that differ)
+	UNIO_TEST_CHECK(unio_test_file(UNIO_TEST_DEVICE_FILE, &unio_test_read_data[0], 0));
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_test_data[0], UNIO_EEPROM_SIZE) == 0);
+	UNIO_TEST_CHECK(unio_image_tool(5, diff_args) == 0);
+
+	UNIO_TEST_CHECK(unio_image_tool(2, usage_args) == 2);
+	remove(UNIO_TEST_DEVICE_FILE);
+	remove(UNIO_TEST_IMAGE_FILE);
+}
+
+
+//Write (write = 1) or read a UNIO_EEPROM_SIZE byte file
+//Returns:
+//	1 if sucessful, 0 if not
+BYTE unio_test_file (const char *filename, uint8_t *data, uint8_t write)
+{
+	FILE *file;
+	size_t length;
+
+	file = fopen(filename, (write ? "wb" : "rb"));
+	if (!file)
+		return(0);
+	if (write)
+		length = fwrite(data, 1, UNIO_EEPROM_SIZE, file);
+	else
+		length = fread(data, 1, UNIO_EEPROM_SIZE, file);
+	fclose(file);
+	return((length == UNIO_EEPROM_SIZE) ? 1 : 0);
+}
+
+
+
+//************************************
+//************************************
+//********** SKIP UNCHANGED **********
+//************************************
+//************************************
+//unio_eeprom_compare() stops at the first byte that differs, and writing data the device already holds costs no write cycle
+//(UNIO_WRITE_SKIP_UNCHANGED)
+void unio_test_skip_unchanged (void)
+{
+	uint8_t count;
+	uint32_t write_cycles;
+	uint32_t bytes_read;
+	UNIO_STATS stats;
+
+	unio_test_name = "skip_unchanged";
+	unio_test_power_on(500);
+
+	for (count = 0; count < UNIO_EEPROM_PAGE_SIZE; count++)
+		unio_test_data[count] = (uint8_t)(count + 1);
+
+	UNIO_TEST_CHECK(unio_eeprom_write(0x0010, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE));
+
+	//----- COMPARE -----
+	unio_test_device_changed();
+	UNIO_TEST_CHECK(unio_eeprom_compare(0x0010, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == UNIO_EEPROM_PAGE_SIZE);
+	unio_test_data[5] ^= 0x10;
+	unio_test_device_changed();
+	bytes_read = unio_sim_stats.bytes_read;
+	UNIO_TEST_CHECK(unio_eeprom_compare(0x0010, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == 5);
+	UNIO_TEST_CHECK((unio_sim_stats.bytes_read - bytes_read) < UNIO_EEPROM_PAGE_SIZE);		//(The read was ended at the first difference)
+	unio_test_data[5] ^= 0x10;
+	UNIO_TEST_CHECK(unio_eeprom_compare((UNIO_EEPROM_SIZE - 4), &unio_test_data[0], 8) == UNIO_COMPARE_FAILED);
+
+	//----- SKIP UNCHANGED -----
+	write_cycles = unio_sim_stats.write_cycles;
+#ifdef UNIO_WRITE_SKIP_UNCHANGED
+	UNIO_TEST_CHECK(unio_eeprom_write_report(0x0010, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == UNIO_WRITE_SKIPPED);
+#else
+	UNIO_TEST_CHECK(unio_eeprom_write_report(0x0010, &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE) == UNIO_WRITE_DONE);
+#endif
+
+	unio_stats_read(&stats);
+#ifdef UNIO_WRITE_SKIP_UNCHANGED
+	UNIO_TEST_CHECK(unio_sim_stats.write_cycles == write_cycles);
+	UNIO_TEST_CHECK(stats.writes_skipped == 1);
+#else
+	UNIO_TEST_CHECK(unio_sim_stats.write_cycles == (write_cycles + 1));
+	UNIO_TEST_CHECK(stats.writes_skipped == 0);
+#endif
+	UNIO_TEST_CHECK(stats.writes == 2);
+
+	//A change in one page of several only writes that page
+	unio_test_data[UNIO_EEPROM_PAGE_SIZE - 1] ^= 0x01;
+	memcpy(&unio_test_model[0x0010], &unio_test_data[0], UNIO_EEPROM_PAGE_SIZE);
+	write_cycles = unio_sim_stats.write_cycles;
+	for (count = 0; count < 3; count++)
+		UNIO_TEST_CHECK(unio_eeprom_write((count * UNIO_EEPROM_PAGE_SIZE), &unio_test_model[count * UNIO_EEPROM_PAGE_SIZE], UNIO_EEPROM_PAGE_SIZE));
+#ifdef UNIO_WRITE_SKIP_UNCHANGED
+	UNIO_TEST_CHECK(unio_sim_stats.write_cycles == (write_cycles + 1));
+#endif
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+}
+
+
+
+//********************************
+//********************************
+//********** READ CACHE **********
+//********************************
+//********************************
+//UNIO_USE_READ_CACHE - repeated reads are served from RAM, a miss also fetches the read ahead pages, the least recently used pages
+//are evicted, and reads after writes return the new data
+void unio_test_read_cache (void)
+{
+#ifdef UNIO_USE_READ_CACHE
+	uint16_t count;
+	uint16_t address;
+	uint8_t length;
+	uint8_t index;
+	uint8_t bad = 0;
+	uint32_t transactions;
+	UNIO_STATS stats;
+
+	unio_test_name = "read_cache";
+	unio_test_power_on(500);
+
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0020, &unio_test_read_data[0], 4));
+	transactions = unio_sim_stats.transactions;
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0024, &unio_test_read_data[0], 4));
+	UNIO_TEST_CHECK(unio_sim_stats.transactions == transactions);
+	unio_stats_read(&stats);
+	UNIO_TEST_CHECK(stats.read_cache_hits >= 1);
+
+	//----- READ AHEAD AND LRU -----
+	unio_read_cache_invalidate();
+	transactions = unio_sim_stats.transactions;
+	UNIO_TEST_CHECK(unio_eeprom_read((UNIO_EEPROM_PAGE_SIZE * 2), &unio_test_read_data[0], 4));
+	UNIO_TEST_CHECK(unio_sim_stats.transactions == (transactions + 1));
+	UNIO_TEST_CHECK(unio_eeprom_read((UNIO_EEPROM_PAGE_SIZE * (2 + UNIO_READ_CACHE_READ_AHEAD)), &unio_test_read_data[0], 4));		//(Fetched with the page before)
+	UNIO_TEST_CHECK(unio_sim_stats.transactions == (transactions + 1));
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0000, &unio_test_read_data[0], 4));
+	UNIO_TEST_CHECK(unio_eeprom_read((UNIO_EEPROM_PAGE_SIZE * 2), &unio_test_read_data[0], 4));
+	for (count = 0; count < UNIO_READ_CACHE_PAGES; count++)
+		UNIO_TEST_CHECK(unio_eeprom_read((UNIO_EEPROM_PAGE_SIZE * (4 + count)), &unio_test_read_data[0], 1));		//(Evict the least recently used pages)
+	transactions = unio_sim_stats.transactions;
+	UNIO_TEST_CHECK(unio_eeprom_read((UNIO_EEPROM_PAGE_SIZE * (4 + UNIO_READ_CACHE_PAGES - 1)), &unio_test_read_data[0], 1));
+	UNIO_TEST_CHECK(unio_sim_stats.transactions == transactions);
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0000, &unio_test_read_data[0], 4));
+	UNIO_TEST_CHECK(unio_sim_stats.transactions == (transactions + 1));
+
+	//----- WRITES UPDATE THE CACHE -----
+	for (count = 0; count < 4; count++)
+		unio_test_data[count] = (uint8_t)(0x5a + count);
+	UNIO_TEST_CHECK(unio_eeprom_write(0x0000, &unio_test_data[0], 4));
+	memcpy(&unio_test_model[0], &unio_test_data[0], 4);
+	UNIO_TEST_CHECK(unio_eeprom_read(0x0000, &unio_test_read_data[0], 4));
+	UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_test_data[0], 4) == 0);
+
+	for (count = 0; count < UNIO_TEST_RANDOM_OPS; count++)
+	{
+		address = unio_test_random() % UNIO_EEPROM_SIZE;
+		length = 1 + (unio_test_random() % UNIO_EEPROM_PAGE_SIZE);
+		if ((address / UNIO_EEPROM_PAGE_SIZE) != ((address + length - 1) / UNIO_EEPROM_PAGE_SIZE))
+			length = (uint8_t)(UNIO_EEPROM_PAGE_SIZE - (address % UNIO_EEPROM_PAGE_SIZE));
+
+		if ((unio_test_random() % 3) == 0)
+		{
+			for (index = 0; index < length; index++)
+				unio_test_data[index] = unio_test_random();
+			if (!unio_eeprom_write(address, &unio_test_data[0], length))
+				bad++;
+			memcpy(&unio_test_model[address], &unio_test_data[0], length);
+		}
+		else
+		{
+			if (!unio_eeprom_read(address, &unio_test_read_data[0], length))
+				bad++;
+			if (memcmp(&unio_test_read_data[0], &unio_test_model[address], length) != 0)
+				bad++;
+		}
+	}
+	UNIO_TEST_CHECK(bad == 0);
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+#endif
+}
+
+
+
+//***************************
+//***************************
+//********** BATCH **********
+//***************************
+//***************************
+//mem-11lcxxx-batch.c - same page writes take one write cycle, nearby reads take one READ, and random batches of reads and writes
+//against the RAM model.  Reads return the data as it was when they were queued, writes are done in the order queued.
+void unio_test_batch (void)
+{
+	static uint8_t write_data[64][8];
+	static uint8_t read_data[32][8];
+	static uint8_t read_expected[32][8];
+	static uint8_t read_length[32];
+	uint16_t count;
+	uint16_t address;
+	uint8_t length;
+	uint8_t index;
+	uint8_t operations;
+	uint8_t writes;
+	uint8_t reads;
+	uint8_t bad = 0;
+	uint32_t write_cycles;
+	uint32_t transactions;
+
+	unio_test_name = "batch";
+	unio_test_power_on(500);
+
+	//----- WRITES TO ONE PAGE ARE FOLDED INTO ONE WRITE CYCLE -----
+	for (index = 0; index < 3; index++)
+	{
+		write_data[index][0] = (uint8_t)(0xa0 + index);
+		write_data[index][1] = (uint8_t)(0xb0 + index);
+		UNIO_TEST_CHECK(unio_batch_write((0x0020 + (index * 5)), &write_data[index][0], 2));		//(0x20-21, 0x25-26, 0x2a-2b - with gaps)
+		memcpy(&unio_test_model[0x0020 + (index * 5)], &write_data[index][0], 2);
+	}
+	write_cycles = unio_sim_stats.write_cycles;
+	UNIO_TEST_CHECK(unio_batch_run());
+	UNIO_TEST_CHECK(unio_sim_stats.write_cycles == (write_cycles + 1));
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+
+	//----- NEARBY READS ARE MERGED INTO ONE READ TRANSACTION -----
+	for (index = 0; index < 6; index++)
+		UNIO_TEST_CHECK(unio_batch_read((0x0040 + (index * 4)), &read_data[index][0], 2));
+	unio_test_device_changed();
+	transactions = unio_sim_stats.transactions;
+	UNIO_TEST_CHECK(unio_batch_run());
+	UNIO_TEST_CHECK(unio_sim_stats.transactions == (transactions + 1));
+	for (index = 0; index < 6; index++)
+		UNIO_TEST_CHECK(memcmp(&read_data[index][0], &unio_test_model[0x0040 + (index * 4)], 2) == 0);
+
+	//----- RANDOM BATCHES -----
+	for (count = 0; count < (UNIO_TEST_RANDOM_OPS / 3); count++)
+	{
+		operations = 1 + (unio_test_random() % 20);
+		writes = 0;
+		reads = 0;
+		for ( ; operations; operations--)
+		{
+			address = unio_test_random() % UNIO_EEPROM_SIZE;
+			length = 1 + (unio_test_random() % 8);
+			if ((address + length) > UNIO_EEPROM_SIZE)
+				length = (uint8_t)(UNIO_EEPROM_SIZE - address);
+
+			if ((unio_test_random() & 0x01) && (writes < 64))
+			{
+				for (index = 0; index < length; index++)
+					write_data[writes][index] = unio_test_random();
+				if (!unio_batch_write(address, &write_data[writes][0], length))
+					bad++;
+				memcpy(&unio_test_model[address], &write_data[writes][0], length);
+				writes++;
+			}
+			else if (reads < 32)
+			{
+				memcpy(&read_expected[reads][0], &unio_test_model[address], length);
+				read_length[reads] = length;
+				if (!unio_batch_read(address, &read_data[reads][0], length))
+					bad++;
+				reads++;
+			}
+		}
+		if (!unio_batch_run())
+			bad++;
+		for (index = 0; index < reads; index++)
+		{
+			if (memcmp(&read_data[index][0], &read_expected[index][0], read_length[index]) != 0)
+				bad++;
+		}
+	}
+	UNIO_TEST_CHECK(bad == 0);
+	UNIO_TEST_CHECK(memcmp(&unio_sim_device.memory[0], &unio_test_model[0], UNIO_EEPROM_SIZE) == 0);
+	UNIO_TEST_CHECK(unio_sim_stats.bus_errors == 0);
+}
+
+
+
+//************************************
+//************************************
+//********** INT OFF BUDGET **********
+//************************************
+//************************************
+//With unio_int_off_budget_us set no read has an interrupt disabled period longer than the budget, pages are still written in one
+//write cycle each (even when a page WRITE is longer than the budget), and the data is unchanged
+void unio_test_int_off_budget (void)
+{
+	uint16_t count;
+	uint8_t budget;
+	UNIO_STATS stats;
+	static const uint16_t budgets_us[] = {3000, 800};
+
+	unio_test_name = "int_off_budget";
+
+	for (budget = 0; budget < (sizeof(budgets_us) / sizeof(budgets_us[0])); budget++)
+	{
+		unio_test_power_on(50);
+		unio_int_off_budget_us = budgets_us[budget];
+
+		for (count = 0; count < UNIO_EEPROM_SIZE; count++)
+			unio_test_model[count] = (uint8_t)((count * 37) + 11 + budget);
+
+		UNIO_TEST_CHECK(unio_eeprom_write_bulk(0x0003, &unio_test_model[3], (0x0070 - 3), 0));
+		UNIO_TEST_CHECK(unio_eeprom_write(0x0070, &unio_test_model[0x70], UNIO_EEPROM_PAGE_SIZE));
+		UNIO_TEST_CHECK(unio_sim_stats.write_cycles == (0x0080 / UNIO_EEPROM_PAGE_SIZE));		//(One write cycle per page whatever the budget)
+		unio_stats_read(&stats);
+		UNIO_TEST_CHECK(stats.failures == 0);
+
+		//Reads stay inside the budget (a page WRITE may not, see unio_int_off_budget_us)
+		unio_stats_reset();
+		unio_sim_stats.int_disabled_max_ns = 0;
+		unio_test_device_changed();
+		UNIO_TEST_CHECK(unio_eeprom_read(0x0003, &unio_test_read_data[0], 120));
+		UNIO_TEST_CHECK(memcmp(&unio_test_read_data[0], &unio_test_model[3], 120) == 0);
+		UNIO_TEST_CHECK(unio_eeprom_compare(0x0003, &unio_test_model[3], 120) == 120);
+
+		unio_stats_read(&stats);
+		UNIO_TEST_CHECK(stats.int_off_max_us <= budgets_us[budget]);
+		UNIO_TEST_CHECK((unio_sim_stats.int_disabled_max_ns / 1000) <= budgets_us[budget]);
+	}
+}
@@ -0,0 +1,153 @@
+/*
+Provided by IBEX UK LTD http://www.ibexuk.com
+Electronic Product Design Specialists
+RELEASED SOFTWARE
+
+The MIT License (MIT)
+
+Copyright (c) IBEX UK Ltd, http://ibexuk.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//Visit http://www.embedded-code.com/source-code/memory/eeprom/microchip-11lcxxx-eeprom-with-uni-o-1-wire-port for more information
+//
+//Project Name:	11LC010T EEPROM USING UNI/O 1 WIRE BUS - HOST TESTS
+
+
+
+//################################
+//################################
+//##### HOST SIMULATOR TESTS #####
+//################################
+//################################
+//Runs the driver and its add on modules against the host simulator (mem-11lcxxx-sim.c) and checks the results against a RAM model
+//of the device (and the simulated device's own array).  Random sequences use a fixed seed so every run is the same.
+//	mem-11lcxxx-test						Run the tests, exit code 0 if all pass
+//	mem-11lcxxx-test --bench-csv			Print the unio_bench_run() CSV (to save as a new baseline)
+//	mem-11lcxxx-test --bench file [percent]	Compare the benchmarks with a saved baseline (unio_bench_check())
+//See Makefile for the builds (each build option combination) and the check, bench and bench-baseline targets.
+
+
+
+//*****************************
+//*****************************
+//********** DEFINES **********
+//*****************************
+//*****************************
+#ifndef MEM_EXT_UNIO_TEST_C_INIT		//(Do only once)
+#define	MEM_EXT_UNIO_TEST_C_INIT
+
+#include "mem-11lcxxx.h"
+
+#define	UNIO_TEST_SEED						12345
+#define	UNIO_TEST_RANDOM_OPS				300			//Operations in each random sequence
+#define	UNIO_TEST_BENCH_THRESHOLD			5			//Default percent a benchmark may be slower than its baseline
+#define	UNIO_TEST_NO_HOOK					0xffffffff
+#define	UNIO_TEST_DEVICE_FILE				"build/test_device.bin"		//unio_test_image() files (make check runs the tests from this directory)
+#define	UNIO_TEST_IMAGE_FILE				"build/test_image.bin"
+#define	UNIO_TEST_OTHER_PERIOD				2000		//unio_test_other_isr() timer period (100uS)
+#define	UNIO_TEST_MIN_QUARTER_PERIOD		200			//Fastest quarter bit period the device follows in unio_test_calibration() (10uS)
+#ifdef UNIO_USE_EDGE_DECODER
+#define	UNIO_TEST_SKEW_LIMIT_PPM			50000		//Device clock error that reads must still work at (unio_sim_device.clock_skew_ppm)
+#else
+#define	UNIO_TEST_SKEW_LIMIT_PPM			20000
+#endif
+
+#define	UNIO_TEST_CHECK(condition)			unio_test_check(((condition) ? 1 : 0), #condition, __LINE__)
+
+
+#endif
+
+
+
+//*******************************
+//*******************************
+//********** FUNCTIONS **********
+//*******************************
+//*******************************
+#ifdef MEM_EXT_UNIO_TEST_C
+//-----------------------------------
+//----- INTERNAL ONLY FUNCTIONS -----
+//-----------------------------------
+void unio_test_check (uint8_t passed, const char *condition, int line);
+uint8_t unio_test_random (void);
+void unio_test_power_on (uint16_t quarter_period);
+void unio_test_device_changed (void);
+void unio_test_read_write (void);
+void unio_test_simulator (void);
+void unio_test_bulk_rewrite (void);
+void unio_test_corrupt_pages (void);
+void unio_test_write_start (void);
+void unio_test_interrupt_gap (void);
+void unio_test_write_cycle_learning (void);
+void unio_test_irq_engine (void);
+void unio_test_kv (void);
+void unio_test_write_cache (void);
+void unio_test_timer_sharing (void);
+void unio_test_other_isr (void);
+void unio_test_clock_skew (void);
+void unio_test_multi (void);
+void unio_test_int_off_balance (void);
+void unio_test_calibration (void);
+void unio_test_glitch (void);
+void unio_test_verify_policies (void);
+void unio_test_image (void);
+BYTE unio_test_file (const char *filename, uint8_t *data, uint8_t write);
+void unio_test_erase_protect (void);
+void unio_test_read_cache (void);
+void unio_test_skip_unchanged (void);
+void unio_test_int_off_budget (void);
+void unio_test_batch (void);
+#ifdef UNIO_USE_IRQ_ENGINE
+void unio_test_irq_load (UNIO_TRANSACTION *transaction, uint8_t command, uint8_t send_address, uint16_t address);
+void unio_test_irq_callback (UNIO_TRANSACTION *transaction);
+#endif
+
+
+#endif
+
+
+
+
+//****************************
+//****************************
+//********** MEMORY **********
+//****************************
+//****************************
+#ifdef MEM_EXT_UNIO_TEST_C
+//--------------------------------------------
+//----- INTERNAL ONLY MEMORY DEFINITIONS -----
+//--------------------------------------------
+const char *unio_test_name;
+uint32_t unio_test_checks;
+uint32_t unio_test_failures;
+uint32_t unio_test_seed;
+uint8_t unio_test_model[UNIO_EEPROM_SIZE];				//What the device should hold
+uint8_t unio_test_data[UNIO_EEPROM_SIZE];
+uint8_t unio_test_read_data[UNIO_EEPROM_SIZE];
+uint32_t unio_test_hook_write_cycles;					//unio_test_corrupt_pages() corrupts unio_test_hook_pages when the device has done this many write cycles
+uint8_t unio_test_hook_pages[2];
+uint8_t unio_test_gap_taken;							//unio_test_interrupt_gap() ran with WEL set
+uint32_t unio_test_other_ticks;							//unio_test_other_isr() calls
+uint32_t unio_test_other_bad;
+uint64_t unio_test_other_last_ns;
+uint8_t unio_test_callbacks;							//Transactions completed (unio_test_irq_callback())
+uint8_t unio_test_callback_status[4];
+
+
+#endif